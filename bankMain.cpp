@@ -0,0 +1,81 @@
+/**
+ *@file bankMain.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief Command line tool that builds a puzzle bank from puzzle packs.
+ *@details Reads the packs written by blackout_batch, one puzzle per line, and writes their puzzles to a puzzle bank file that the game maps into memory.
+ *Usage: blackout_bank bankFile packFile [packFile ...]
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <inttypes.h>
+
+#include "puzzleBankWriter.h"
+
+int main (int argc, char *argv[])
+{
+  PuzzleBankWriter writer;
+  char line[256];
+  uint64_t id, state;
+  int size, moves, i;
+  FILE *packFile;
+
+  if (argc < 3)
+    {
+      std::cerr << "Usage: " << argv[0] << " bankFile packFile [packFile ...]\n";
+      return (1);
+    }
+
+  for (i=2; i<argc; i++)
+    {
+      packFile = fopen (argv[i], "r");
+      if (!packFile)
+	{
+	  std::cerr << "Cannot read " << argv[i] << "\n";
+	  return (1);
+	}
+      // Lines: id size state moves, comments start with #
+      while (fgets (line, sizeof (line), packFile))
+	{
+	  if (line[0] == '#' || line[0] == '\n')
+	    {
+	      continue;
+	    }
+	  if (sscanf (line, "%" SCNu64 " %d %" SCNx64 " %d", &id, &size, &state, &moves) != 4 || !writer.addPuzzle (size, state, moves))
+	    {
+	      std::cerr << "Malformed line in " << argv[i] << ": " << line;
+	      fclose (packFile);
+	      return (1);
+	    }
+	}
+      fclose (packFile);
+    }
+
+  if (!writer.write (argv[1]))
+    {
+      std::cerr << "Cannot write " << argv[1] << "\n";
+      return (1);
+    }
+
+  return (0);
+}
@@ -0,0 +1,248 @@
+/**
+ *@file batchGenerator.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class BatchGenerator.
+ *@details The BatchGenerator class generates packs of puzzles without user interaction.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <inttypes.h>
+#include <thread>
+#include <vector>
+
+#include "batchGenerator.h"
+#include "fixedBoard.h"
+
+/**
+ * Constructor that sets the parameters of the pack.
+ * @param sideLength The side of the square board.
+ * @param count Number of puzzles in the pack.
+ * @param minimumMoves Fewest moves needed to solve a puzzle of the pack.
+ * @param maximumMoves Most moves needed to solve a puzzle of the pack.
+ * @param seed The master seed of the pack.
+ * @param threads Number of threads generating puzzles. If 0, one per available core.
+ */
+BatchGenerator::BatchGenerator (int sideLength, uint64_t count, int minimumMoves, int maximumMoves, uint64_t seed, int threads)
+{
+  this->boardSize = sideLength;
+  this->nPuzzles = count;
+  this->minMoves = minimumMoves;
+  this->maxMoves = maximumMoves;
+  this->masterSeed = seed;
+
+  this->nThreads = threads;
+  if (this->nThreads <= 0)
+    {
+      this->nThreads = (int) std::thread::hardware_concurrency ();
+    }
+  if (this->nThreads <= 0)
+    {
+      this->nThreads = 1;
+    }
+
+  this->outFile = NULL;
+  this->nextWrite = 0;
+}
+
+/**
+ * Generates the pack and writes it to the file with the given name. The return value is false if the file cannot be written or a puzzle within the difficulty band cannot be found.
+ * @param fileName Name of the file to which the pack is written.
+ */
+bool BatchGenerator::generate (const char *fileName)
+{
+  std::vector<std::thread> workers;
+  int i;
+
+  this->outFile = fopen (fileName, "w");
+  if (!this->outFile)
+    {
+      return (false);
+    }
+
+  fprintf (this->outFile, "# size %d count %" PRIu64 " moves %d-%d seed %" PRIu64 "\n", this->boardSize, this->nPuzzles, this->minMoves, this->maxMoves, this->masterSeed);
+
+  this->nextChunk.store (0);
+  this->nextWrite = 0;
+  this->failed.store (false);
+
+  for (i=1; i<this->nThreads; i++)
+    {
+      workers.push_back (std::thread (&BatchGenerator::work, this));
+    }
+  this->work ();
+  for (i=0; i<(int) workers.size (); i++)
+    {
+      workers[i].join ();
+    }
+
+  if (fclose (this->outFile) != 0)
+    {
+      this->failed.store (true);
+    }
+  this->outFile = NULL;
+
+  return (!this->failed.load ());
+}
+
+/**
+ * Calls workWith with the FixedBlackout of the board size.
+ */
+struct BatchGenerator::WorkJob
+{
+  BatchGenerator *generator;
+
+  template <int N>
+  void run ()
+  {
+    this->generator->workWith<FixedBlackout<N> > ();
+  }
+};
+
+/**
+ * Generates chunks of puzzles, claimed one after the other, and writes each to the file in its turn. The games are FixedBlackout games when the board size has one, and Blackout games otherwise.
+ */
+void BatchGenerator::work ()
+{
+  WorkJob job = { this };
+
+  if (!dispatchFixedSize (this->boardSize, job))
+    {
+      this->workWith<Blackout> ();
+    }
+}
+
+/**
+ * Returns a new game of class Game with a board of the given size. The size of a FixedBlackout is its template parameter.
+ * @param size The side of the board.
+ */
+template <class Game>
+static Game *newBatchGame (int)
+{
+  return (new Game ());
+}
+
+template <>
+Blackout *newBatchGame<Blackout> (int size)
+{
+  return (new Blackout (size));
+}
+
+/**
+ * Generates chunks of puzzles, claimed one after the other, with games of the class Game, and writes each to the file in its turn.
+ */
+template <class Game>
+void BatchGenerator::workWith ()
+{
+  Game *game = newBatchGame<Game> (this->boardSize);
+  std::string text;
+  char line[64];
+  uint64_t chunk, id, first, last, puzzle;
+  int moves;
+
+  while (!this->failed.load ())
+    {
+      chunk = this->nextChunk.fetch_add (1);
+      first = chunk * BATCH_CHUNK_SIZE;
+      if (first >= this->nPuzzles)
+	{
+	  break;
+	}
+      last = first + BATCH_CHUNK_SIZE;
+      if (last > this->nPuzzles)
+	{
+	  last = this->nPuzzles;
+	}
+
+      text.clear ();
+      for (id=first; id<last; id++)
+	{
+	  moves = this->generatePuzzle (id, game, &puzzle);
+	  if (moves < 0)
+	    {
+	      this->failed.store (true);
+	      break;
+	    }
+	  snprintf (line, sizeof (line), "%" PRIu64 " %d %016" PRIx64 " %d\n", id, this->boardSize, puzzle, moves);
+	  text += line;
+	}
+
+      // Chunks are written in order, so wait for the previous one
+      std::unique_lock<std::mutex> lock (this->writeMutex);
+      while (this->nextWrite != chunk && !this->failed.load ())
+	{
+	  this->written.wait (lock);
+	}
+      if (!this->failed.load ())
+	{
+	  if (fwrite (text.data (), 1, text.size (), this->outFile) != text.size ())
+	    {
+	      this->failed.store (true);
+	    }
+	}
+      this->nextWrite = chunk + 1;
+      this->written.notify_all ();
+    }
+
+  // Wake up any thread waiting for a chunk that will never come
+  std::unique_lock<std::mutex> lock (this->writeMutex);
+  this->written.notify_all ();
+  lock.unlock ();
+  delete (game);
+}
+
+/**
+ * Generates puzzle number id and returns its difficulty, or -1 if no puzzle within the difficulty band was found.
+ * @param id The number of the puzzle in the pack.
+ * @param game The game in which candidate puzzles are set up and rated.
+ * @param puzzle Pointer to the location where the state of the puzzle is copied.
+ */
+template <class Game>
+int BatchGenerator::generatePuzzle (uint64_t id, Game *game, uint64_t *puzzle)
+{
+  // The stream of the puzzle depends only on the master seed and the puzzle id
+  uint64_t key = this->masterSeed ^ (id * 0xD1342543DE82EF95ULL);
+  RandomGenerator random (splitMix64 (&key));
+  uint64_t presses;
+  int attempt, moves;
+
+  for (attempt=0; attempt<BATCH_MAX_ATTEMPTS; attempt++)
+    {
+      // A uniform random set of presses gives a uniform solvable state, as in Blackout::generateGame
+      presses = random.next ();
+      game->newGame (0);
+      game->applyPresses (&presses);
+      game->newGame (game->getState ());
+      if (game->checkWinCondition ())
+	{
+	  continue;
+	}
+      moves = game->getOptimalMoves ();
+      if (moves >= this->minMoves && moves <= this->maxMoves)
+	{
+	  *puzzle = game->getState ();
+	  return (moves);
+	}
+    }
+
+  return (-1);
+}
@@ -0,0 +1,159 @@
+/**
+ *@file batchGenerator.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class BatchGenerator.
+ *@details The BatchGenerator class generates packs of puzzles without user interaction.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BATCHGENERATOR_H
+#define BATCHGENERATOR_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+
+#include "blackout.h"
+
+/**
+ * Number of puzzles generated by a thread in one go, and written to the file together.
+ */
+#ifndef BATCH_CHUNK_SIZE
+#define BATCH_CHUNK_SIZE 4096
+#endif
+
+/**
+ * Number of states drawn for a puzzle before giving up on finding one within the difficulty band.
+ */
+#ifndef BATCH_MAX_ATTEMPTS
+#define BATCH_MAX_ATTEMPTS 1000000
+#endif
+
+/**
+ * The smallest side of the boards of a pack. A 1x1 board has no state that is not already won, so no puzzle could ever be drawn for it.
+ */
+#ifndef MIN_BATCH_BOARDSIZE
+#define MIN_BATCH_BOARDSIZE 2
+#endif
+
+/**
+ * The BatchGenerator class generates a pack of puzzles of one board size whose difficulty, the fewest moves needed to solve them, lies within a given band. The puzzles are generated by all threads and streamed to a file in order, one line per puzzle: the puzzle id, the board size, the state of the board in hexadecimal (cell (x, y) in bit (x-1)*size + (y-1)) and the difficulty.
+ * Puzzle number i is drawn from a random stream seeded by the master seed and i alone, so a given seed always produces the same pack, whatever the number of threads.
+ */
+class BatchGenerator
+{
+ private:
+  /**
+   * The side of the square board.
+   */
+  int boardSize;
+  /**
+   * Number of puzzles in the pack.
+   */
+  uint64_t nPuzzles;
+  /**
+   * Fewest moves needed to solve a puzzle of the pack.
+   */
+  int minMoves;
+  /**
+   * Most moves needed to solve a puzzle of the pack.
+   */
+  int maxMoves;
+  /**
+   * The seed from which the seeds of all puzzles are derived.
+   */
+  uint64_t masterSeed;
+  /**
+   * Number of threads generating puzzles.
+   */
+  int nThreads;
+  /**
+   * The file to which the pack is written.
+   */
+  FILE *outFile;
+  /**
+   * Index of the next chunk to be claimed by a thread.
+   */
+  std::atomic<uint64_t> nextChunk;
+  /**
+   * Index of the next chunk to be written to the file.
+   */
+  uint64_t nextWrite;
+  /**
+   * Set when a puzzle could not be generated or the file could not be written.
+   */
+  std::atomic<bool> failed;
+  /**
+   * Guards nextWrite and the file.
+   */
+  std::mutex writeMutex;
+  /**
+   * Signalled each time a chunk is written.
+   */
+  std::condition_variable written;
+
+  /**
+   * Calls workWith with the FixedBlackout of the board size.
+   */
+  struct WorkJob;
+
+  /**
+   * Generates chunks of puzzles, claimed one after the other, and writes each to the file in its turn. The games are FixedBlackout games when the board size has one, and Blackout games otherwise.
+   */
+  void work ();
+  /**
+   * Generates chunks of puzzles, claimed one after the other, with games of the class Game, and writes each to the file in its turn.
+   */
+  template <class Game>
+  void workWith ();
+  /**
+   * Generates puzzle number id and returns its difficulty, or -1 if no puzzle within the difficulty band was found.
+   * @param id The number of the puzzle in the pack.
+   * @param game The game in which candidate puzzles are set up and rated.
+   * @param puzzle Pointer to the location where the state of the puzzle is copied.
+   */
+  template <class Game>
+  int generatePuzzle (uint64_t id, Game *game, uint64_t *puzzle);
+
+ public:
+  /**
+   * Constructor that sets the parameters of the pack.
+   * @param sideLength The side of the square board.
+   * @param count Number of puzzles in the pack.
+   * @param minimumMoves Fewest moves needed to solve a puzzle of the pack.
+   * @param maximumMoves Most moves needed to solve a puzzle of the pack.
+   * @param seed The master seed of the pack.
+   * @param threads Number of threads generating puzzles. If 0, one per available core.
+   */
+  BatchGenerator (int sideLength, uint64_t count, int minimumMoves, int maximumMoves, uint64_t seed, int threads=0);
+  /**
+   * Generates the pack and writes it to the file with the given name. The return value is false if the file cannot be written or a puzzle within the difficulty band cannot be found.
+   * @param fileName Name of the file to which the pack is written.
+   */
+  bool generate (const char *fileName);
+};
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ *@file batchMain.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief Command line tool that generates packs of puzzles.
+ *@details Generates a pack of puzzles of one board size within a difficulty band, from a master seed, using every core.
+ *Usage: blackout_batch size count minMoves maxMoves seed outputFile [threads]
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+
+#include "batchGenerator.h"
+
+int main (int argc, char *argv[])
+{
+  int size, minMoves, maxMoves;
+  int threads = 0;
+  uint64_t count, seed;
+
+  if (argc < 7)
+    {
+      std::cerr << "Usage: " << argv[0] << " size count minMoves maxMoves seed outputFile [threads]\n";
+      std::cerr << "size is the side of the board, within " << MIN_BATCH_BOARDSIZE << "-" << MAX_GAMESQUARESIZE << "\n";
+      return (1);
+    }
+
+  size = atoi (argv[1]);
+  count = strtoull (argv[2], NULL, 10);
+  minMoves = atoi (argv[3]);
+  maxMoves = atoi (argv[4]);
+  seed = strtoull (argv[5], NULL, 10);
+  if (argc > 7)
+    {
+      threads = atoi (argv[7]);
+    }
+
+  if (size < MIN_BATCH_BOARDSIZE || size > MAX_GAMESQUARESIZE)
+    {
+      std::cerr << "Board size must be within " << MIN_BATCH_BOARDSIZE << "-" << MAX_GAMESQUARESIZE << "\n";
+      return (1);
+    }
+  if (minMoves > maxMoves)
+    {
+      std::cerr << "Empty difficulty band\n";
+      return (1);
+    }
+
+  BatchGenerator generator (size, count, minMoves, maxMoves, seed, threads);
+  if (!generator.generate (argv[6]))
+    {
+      std::cerr << "Failed to generate the pack\n";
+      return (1);
+    }
+
+  return (0);
+}
@@ -0,0 +1,476 @@
+/**
+ *@file benchMain.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief Command line tool that benchmarks the game engine.
+ *@details Times the operations on the hot paths of the game engine for every board size, and writes one line of JSON per operation and size.
+ *Usage: blackout_bench [minSeconds [outputFile]]
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "benchmark.h"
+#include "blackout.h"
+#include "multiBoard.h"
+#include "fixedBoard.h"
+#include "modBlackout.h"
+
+/**
+ * Name of the text save file used by the benchmarks.
+ */
+#ifndef BENCH_TEXT_FILE
+#define BENCH_TEXT_FILE "blackout_bench.txt"
+#endif
+
+/**
+ * Name of the binary save file used by the benchmarks.
+ */
+#ifndef BENCH_BINARY_FILE
+#define BENCH_BINARY_FILE "blackout_bench.bko"
+#endif
+
+/**
+ * The large boards benchmarked have sides 16, 64, 256 and so on up to this size.
+ */
+#ifndef BENCH_MAX_LARGE_SIZE
+#define BENCH_MAX_LARGE_SIZE 4096
+#endif
+
+/**
+ * Results of the operations are added to this, so that the compiler cannot drop them.
+ */
+static volatile uint64_t sink;
+
+/**
+ * Runs the benchmarks of the FixedBlackout and FixedBoard of a size, next to those of the Blackout and Board classes of the same size.
+ */
+struct FixedBenchmark
+{
+  Benchmark *bench;
+
+  template <int N>
+  void run ()
+  {
+    FixedBlackout<N> game;
+    FixedBoard<N> board;
+
+    seedRandomGenerator (N);
+    game.generateGame ();
+
+    this->bench->run ("FixedBlackout::applyMove", N, [&] (uint64_t iterations)
+		      {
+			for (uint64_t i=0; i<iterations; i++)
+			  {
+			    game.applyMove ((int) (i % N) + 1, (int) ((i / N) % N) + 1);
+			  }
+			sink += game.getState ();
+		      });
+    this->bench->run ("FixedBlackout::checkWinCondition", N, [&] (uint64_t iterations)
+		      {
+			uint64_t wins = 0;
+			for (uint64_t i=0; i<iterations; i++)
+			  {
+			    game.applyMove ((int) (i % N) + 1, 1);
+			    wins += game.checkWinCondition ();
+			  }
+			sink += wins;
+		      });
+    this->bench->run ("FixedBoard::pressCells", N, [&] (uint64_t iterations)
+		      {
+			for (uint64_t i=0; i<iterations; i++)
+			  {
+			    board.pressCells (i * 0x9E3779B97F4A7C15ULL);
+			  }
+			sink += board.getState ();
+		      });
+  }
+};
+
+/**
+ * Runs the benchmarks of the game engine on a board of the given size.
+ * @param bench The benchmark runner.
+ * @param n The side of the square board.
+ */
+static void benchmarkSize (Benchmark *bench, int n)
+{
+  Blackout game (n);
+  Board board (n);
+  MultiBoard boards (n);
+  ModBlackout modGame (n);
+  uint64_t presses, wins[MULTIBOARD_WORDS];
+  int counts[MAX_MULTIBOARD_BOARDS];
+  unsigned char modState[MAX_BOARDSIZE*MAX_BOARDSIZE], modPresses[MAX_BOARDSIZE*MAX_BOARDSIZE];
+
+  seedRandomGenerator (n);
+  game.generateGame ();
+
+  bench->run ("Blackout::applyMove", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    game.applyMove ((int) (i % n) + 1, (int) ((i / n) % n) + 1);
+		  }
+	      });
+  bench->run ("Blackout::flipCell", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    game.flipCell ((int) (i % n) + 1, (int) ((i / n) % n) + 1);
+		  }
+	      });
+  bench->run ("Blackout::checkWinCondition", n, [&] (uint64_t iterations)
+	      {
+		uint64_t wins = 0;
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    wins += game.checkWinCondition ();
+		  }
+		sink += wins;
+	      });
+  bench->run ("Blackout::undo+redo", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    game.undo ();
+		    game.redo ();
+		  }
+	      });
+  bench->run ("Blackout::generateGame", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    sink += game.generateGame ();
+		  }
+	      });
+  // The solution is found once, then every move updates it
+  sink += game.getMovesRemaining ();
+  bench->run ("Blackout::applyMove+getMovesRemaining", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    game.applyMove ((int) (i % n) + 1, (int) ((i / n) % n) + 1);
+		    sink += game.getMovesRemaining ();
+		  }
+	      });
+
+  bench->run ("Blackout::solve(gaussian)", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    game.solve (&presses, SOLVE_GAUSSIAN);
+		    sink += presses;
+		  }
+	      });
+  bench->run ("Blackout::solve(chase)", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    game.solve (&presses, SOLVE_CHASE);
+		    sink += presses;
+		  }
+	      });
+  bench->run ("Blackout::solve(optimal)", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    game.solve (&presses, SOLVE_OPTIMAL);
+		    sink += presses;
+		  }
+	      });
+  bench->run ("Blackout::applyPresses", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    sink += game.applyPresses (&presses);
+		  }
+	      });
+
+  bench->run ("Blackout::saveGame", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    game.saveGame (BENCH_TEXT_FILE);
+		  }
+	      });
+  bench->run ("Blackout::loadGame", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    sink += game.loadGame (BENCH_TEXT_FILE);
+		  }
+	      });
+  bench->run ("Blackout::saveGameBinary", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    game.saveGameBinary (BENCH_BINARY_FILE);
+		  }
+	      });
+  bench->run ("Blackout::loadGameBinary", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    sink += game.loadGameBinary (BENCH_BINARY_FILE);
+		  }
+	      });
+
+  board.setState (getRandomWord ());
+  bench->run ("Board::setInitialState", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    board.setInitialState ();
+		  }
+	      });
+  bench->run ("Board::resetBoard", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    board.resetBoard ();
+		  }
+	      });
+
+  // Each operation plays on all MAX_MULTIBOARD_BOARDS boards
+  for (int lane=0; lane<boards.getBoardCount (); lane++)
+    {
+      boards.setBoard (lane, getRandomWord ());
+    }
+  bench->run ("MultiBoard::applyMove", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    boards.applyMove ((int) (i % n) + 1, (int) ((i / n) % n) + 1);
+		  }
+	      });
+  bench->run ("MultiBoard::checkWins", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    sink += boards.checkWins (wins);
+		  }
+	      });
+  bench->run ("MultiBoard::countLitCells", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    boards.countLitCells (counts);
+		    sink += counts[i % MAX_MULTIBOARD_BOARDS];
+		  }
+	      });
+
+  modGame.generateGame ();
+  bench->run ("ModBlackout::applyMove", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    modGame.applyMove ((int) (i % n) + 1, (int) ((i / n) % n) + 1);
+		  }
+		sink += modGame.getMoves ();
+	      });
+  bench->run ("ModBlackout::checkWinCondition", n, [&] (uint64_t iterations)
+	      {
+		uint64_t modWins = 0;
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    modGame.applyMove ((int) (i % n) + 1, 1);
+		    modWins += modGame.checkWinCondition ();
+		  }
+		sink += modWins;
+	      });
+  for (int i=0; i<n*n; i++)
+    {
+      modState[i] = (unsigned char) (i % DEFAULT_MOD_STATES);
+    }
+  bench->run ("ModSolver::solve", n, [&] (uint64_t iterations)
+	      {
+		ModSolver *modSolver = ModSolver::forRule (n, DEFAULT_MOD_STATES, Neighbourhood ());
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    modState[i % (n*n)] = (unsigned char) ((modState[i % (n*n)] + 1) % DEFAULT_MOD_STATES);
+		    sink += modSolver->solve (modState, modPresses);
+		  }
+	      });
+
+  FixedBenchmark fixed = { bench };
+  dispatchFixedSize (n, fixed);
+
+  remove (BENCH_TEXT_FILE);
+  remove (BENCH_BINARY_FILE);
+}
+
+/**
+ * Runs the benchmarks of the operations of a large board, whose rows are stored in words.
+ * @param bench The benchmark runner.
+ * @param n The side of the square board.
+ */
+static void benchmarkLargeSize (Benchmark *bench, int n)
+{
+  Blackout game (n);
+  Board board (n);
+  std::vector<uint64_t> state, pattern;
+
+  seedRandomGenerator (n);
+  game.generateGame ();
+
+  bench->run ("Blackout::applyMove", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    game.applyMove ((int) (i % n) + 1, (int) ((i / n) % n) + 1);
+		  }
+	      });
+  bench->run ("Blackout::checkWinCondition", n, [&] (uint64_t iterations)
+	      {
+		uint64_t wins = 0;
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    wins += game.checkWinCondition ();
+		  }
+		sink += wins;
+	      });
+  bench->run ("Blackout::generateGame", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    sink += game.generateGame ();
+		  }
+	      });
+  // The solution is found once, then every move updates it
+  sink += game.getMovesRemaining ();
+  bench->run ("Blackout::applyMove+getMovesRemaining", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    game.applyMove ((int) (i % n) + 1, (int) ((i / n) % n) + 1);
+		    sink += game.getMovesRemaining ();
+		  }
+	      });
+  // Every other cell of every row pressed
+  pattern.assign (game.getPressWords (), 0);
+  for (uint64_t i=0; i<(uint64_t) n; i++)
+    {
+      for (uint64_t j=0; j<(uint64_t) n; j+=2)
+	{
+	  pattern[i * ((n + 63) / 64) + j / 64] |= ((uint64_t) 1) << (j % 64);
+	}
+    }
+  bench->run ("Blackout::applyPresses", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    sink += game.applyPresses (&pattern[0]);
+		  }
+	      });
+  // The solver of the size is built before the first timed run
+  if (game.solve (&pattern[0]))
+    {
+      bench->run ("Blackout::solve", n, [&] (uint64_t iterations)
+		  {
+		    for (uint64_t i=0; i<iterations; i++)
+		      {
+			sink += game.solve (&pattern[0]);
+		      }
+		  });
+    }
+
+  // A random board, and a snapshot of it
+  for (uint64_t i=0; i<(uint64_t) n*n/4; i++)
+    {
+      board.flipCell ((int) (getRandomWord () % n) + 1, (int) (getRandomWord () % n) + 1);
+    }
+  state.resize (board.getStateWords ());
+  bench->run ("Board::snapshot", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    board.snapshot (&state[0]);
+		  }
+	      });
+  bench->run ("Board::restore", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    board.restore (&state[0]);
+		  }
+	      });
+  board.pressCell (n/2, n/2);
+  bench->run ("Board::countDifferences", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    sink += board.countDifferences (&state[0]);
+		  }
+	      });
+  bench->run ("Board::setInitialState", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    board.setInitialState ();
+		  }
+	      });
+  bench->run ("Board::resetBoard", n, [&] (uint64_t iterations)
+	      {
+		for (uint64_t i=0; i<iterations; i++)
+		  {
+		    board.resetBoard ();
+		  }
+	      });
+}
+
+int main (int argc, char *argv[])
+{
+  double minSeconds = 0.2;
+  FILE *outFile = stdout;
+  int n;
+
+  if (argc > 1)
+    {
+      minSeconds = atof (argv[1]);
+    }
+  if (argc > 2)
+    {
+      outFile = fopen (argv[2], "w");
+      if (!outFile)
+	{
+	  std::cerr << "Cannot write " << argv[2] << "\n";
+	  return (1);
+	}
+    }
+
+  Benchmark bench (outFile, minSeconds);
+  for (n=DEFAULT_GAMESQUARESIZE; n<=MAX_GAMESQUARESIZE; n++)
+    {
+      benchmarkSize (&bench, n);
+    }
+  for (n=16; n<=BENCH_MAX_LARGE_SIZE; n*=4)
+    {
+      benchmarkLargeSize (&bench, n);
+    }
+
+  if (outFile != stdout)
+    {
+      fclose (outFile);
+    }
+  return (0);
+}
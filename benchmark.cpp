@@ -0,0 +1,111 @@
+/**
+ *@file benchmark.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class Benchmark.
+ *@details The Benchmark class times operations of the game engine and reports the results.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <atomic>
+#include <new>
+
+#include "benchmark.h"
+
+/**
+ * Number of calls to operator new.
+ */
+static std::atomic<uint64_t> allocationCount (0);
+
+void *operator new (size_t size)
+{
+  void *p;
+
+  allocationCount.fetch_add (1, std::memory_order_relaxed);
+  p = malloc (size ? size : 1);
+  if (!p)
+    {
+      throw std::bad_alloc ();
+    }
+  return (p);
+}
+
+void *operator new[] (size_t size)
+{
+  return (operator new (size));
+}
+
+void operator delete (void *p) noexcept
+{
+  free (p);
+}
+
+void operator delete[] (void *p) noexcept
+{
+  free (p);
+}
+
+void operator delete (void *p, size_t) noexcept
+{
+  free (p);
+}
+
+void operator delete[] (void *p, size_t) noexcept
+{
+  free (p);
+}
+
+/**
+ * Returns the number of calls to operator new made so far by the program. It is counted by the replacement of the global operator new defined in benchmark.cpp.
+ */
+uint64_t getAllocationCount ()
+{
+  return (allocationCount.load (std::memory_order_relaxed));
+}
+
+/**
+ * Constructor that sets where the results are written and for how long each operation is run.
+ * @param out The file to which the results are written.
+ * @param minimumSeconds Minimum time, in seconds, for which each operation is run.
+ */
+Benchmark::Benchmark (FILE *out, double minimumSeconds)
+{
+  this->outFile = out;
+  this->minSeconds = minimumSeconds;
+}
+
+/**
+ * Writes the result of a benchmark.
+ * @param name Name of the operation.
+ * @param boardSize Side of the board on which the operation is run.
+ * @param iterations Number of times the operation was run.
+ * @param seconds Time taken by all iterations.
+ * @param allocations Number of allocations made by all iterations.
+ */
+void Benchmark::report (const char *name, int boardSize, uint64_t iterations, double seconds, uint64_t allocations)
+{
+  fprintf (this->outFile, "{\"benchmark\": \"%s\", \"size\": %d, \"iterations\": %" PRIu64 ", \"ns_per_op\": %.3f, \"allocs_per_op\": %.3f, \"ops_per_sec\": %.1f}\n",
+	   name, boardSize, iterations, 1e9 * seconds / (double) iterations, (double) allocations / (double) iterations, seconds > 0 ? (double) iterations / seconds : 0.0);
+  fflush (this->outFile);
+}
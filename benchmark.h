@@ -0,0 +1,106 @@
+/**
+ *@file benchmark.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class Benchmark.
+ *@details The Benchmark class times operations of the game engine and reports the results.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+
+/**
+ * Returns the number of calls to operator new made so far by the program. It is counted by the replacement of the global operator new defined in benchmark.cpp.
+ */
+uint64_t getAllocationCount ();
+
+/**
+ * The Benchmark class runs an operation in batches of growing size until it has run for a minimum time, and writes one line of JSON per operation and board size with the time per operation, the allocations per operation and the throughput:
+ * {"benchmark": name, "size": board size, "iterations": n, "ns_per_op": t, "allocs_per_op": a, "ops_per_sec": r}
+ */
+class Benchmark
+{
+ private:
+  /**
+   * The file to which the results are written.
+   */
+  FILE *outFile;
+  /**
+   * Minimum time, in seconds, for which each operation is run.
+   */
+  double minSeconds;
+
+  /**
+   * Writes the result of a benchmark.
+   * @param name Name of the operation.
+   * @param boardSize Side of the board on which the operation is run.
+   * @param iterations Number of times the operation was run.
+   * @param seconds Time taken by all iterations.
+   * @param allocations Number of allocations made by all iterations.
+   */
+  void report (const char *name, int boardSize, uint64_t iterations, double seconds, uint64_t allocations);
+
+ public:
+  /**
+   * Constructor that sets where the results are written and for how long each operation is run.
+   * @param out The file to which the results are written.
+   * @param minimumSeconds Minimum time, in seconds, for which each operation is run.
+   */
+  Benchmark (FILE *out, double minimumSeconds);
+  /**
+   * Times an operation. The operation is called with a number of iterations and must run that many times; the number doubles until the run lasts minSeconds.
+   * @param name Name of the operation.
+   * @param boardSize Side of the board on which the operation is run.
+   * @param operation Function object called with the number of iterations to run.
+   */
+  template <typename Operation>
+  void run (const char *name, int boardSize, Operation operation)
+  {
+    uint64_t iterations = 1;
+    uint64_t allocations;
+    double seconds;
+
+    while (true)
+      {
+	allocations = getAllocationCount ();
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+	operation (iterations);
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+	allocations = getAllocationCount () - allocations;
+	seconds = elapsed.count ();
+	if (seconds >= this->minSeconds || iterations >= (((uint64_t) 1) << 40))
+	  {
+	    break;
+	  }
+	iterations *= 2;
+      }
+
+    this->report (name, boardSize, iterations, seconds, allocations);
+  }
+};
+
+#endif
@@ -30,22 +30,97 @@
 
 /**
  * Constructor that initializes the game.
+ * @param boardSize The side of the board. Default value: DEFAULT_GAMESQUARESIZE.
+ * @param rule The cells flipped by a move, ignored on a large board. Default value: the plus rule.
  */
-Blackout::Blackout (int boardSize)
+Blackout::Blackout (int boardSize, const Neighbourhood &rule)
 {
-  // Initialize the board
-  this->b = new Board(boardSize);
-  this->nPoints = boardSize;
+  // Initialize the board. It starts with all cells set to 0.
+  this->b = new Board(boardSize, rule);
+  this->nPoints = this->b->getSize ();
+  this->solver = Solver::forNeighbourhood (this->nPoints, rule);
+  this->journal = new MoveJournal();
+  this->nMoves = 0;
+  this->highScore = 0;
+  this->win = false;
+  this->solutionKnown = false;
+  this->movesRemaining = -1;
+}
 
-  // Fill the board with 0's
-  int i, j;
-  for (i=1; i<=boardSize; i++)
+/**
+ * Destructor that frees the board.
+ */
+Blackout::~Blackout ()
+{
+  this->solver = NULL;
+  delete (this->journal);
+  this->journal = NULL;
+  delete (this->b);
+  this->b = NULL;
+}
+
+/**
+ * Builds a game of the size recorded in a save file and loads the file into it, so that a saved game of any size can be loaded without knowing its size beforehand. The size is checked against maxSize and against the length of the file before the game is built. The return value is the new game, to be freed by the caller, or NULL if the file cannot be read, is not a save of a game of the plus rule, or records a size above maxSize or too large for its length.
+ * @param fileName Name of the file from which to load the game.
+ * @param binary Whether the file is in the binary format of saveGameBinary rather than the text format of saveGame.
+ * @param maxSize The largest side accepted. Default value: MAX_LARGE_BOARDSIZE.
+ */
+Blackout *Blackout::fromFile (const char *fileName, bool binary, int maxSize)
+{
+  Blackout *game;
+  int boardSize = 0;
+  int64_t fileLength;
+  bool valid, loaded;
+
+  std::ifstream inFile (fileName, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!inFile.is_open ())
+    {
+      return (NULL);
+    }
+  fileLength = (int64_t) inFile.tellg ();
+
+  // Only the size is read here; the whole file is verified by the load
+  if (binary)
+    {
+      unsigned char header[6];
+      inFile.seekg (0);
+      inFile.read ((char *) header, 6);
+      valid = inFile.gcount () == 6 && fileLength == BINARY_SAVE_SIZE;
+      if (valid)
+	{
+	  boardSize = header[5];
+	}
+    }
+  else
     {
-      for (j=1; j<=boardSize; j++)
+      FILE *textFile = fopen (fileName, "r");
+      if (!textFile)
 	{
-	  this->b->setCellValue (i, j, 0);
+	  return (NULL);
 	}
+      TextReader reader (textFile);
+      valid = reader.expect ("Board") && reader.expect ("size:") && reader.nextInteger (&boardSize);
+      fclose (textFile);
     }
+  inFile.close ();
+  if (!valid || boardSize < 1 || boardSize > maxSize || boardSize > MAX_LARGE_BOARDSIZE)
+    {
+      return (NULL);
+    }
+  // A text save holds a digit for every cell of the current and the initial state
+  if (!binary && fileLength < 2 * (int64_t) boardSize * boardSize)
+    {
+      return (NULL);
+    }
+
+  game = new Blackout (boardSize);
+  loaded = binary ? game->loadGameBinary (fileName) : game->loadGame (fileName);
+  if (!loaded)
+    {
+      delete (game);
+      return (NULL);
+    }
+  return (game);
 }
 
 /**
@@ -55,98 +130,316 @@ Blackout::Blackout (int boardSize)
  */
 bool Blackout::applyMove (int x, int y)
 {
-  if (x<=0 || x>this->nPoints || y <=0 || y>this->nPoints)
+  ScopedTimer timer (OP_APPLY_MOVE);
+
+  // The cell and its neighbours are flipped together by one XOR with the move mask
+  if (!this->b->pressCell (x, y))
   {
     return (false);
   }
-  
-  this->flipCell (x, y);
 
-  // Flip above
-  if (x!=1)
+  this->journal->record ((uint32_t) (x-1) * (uint32_t) this->nPoints + (uint32_t) (y-1));
+  this->togglePress (x, y);
+  (this->nMoves)++;
+  INSTRUMENT_COUNT (COUNT_MOVES, 1);
+  INSTRUMENT_COUNT (COUNT_FLIPS, (uint64_t) this->b->getMoveSize (x, y));
+  return (true);
+}
+
+/**
+ * Presses every cell set in a press pattern at once, for instance a solution or a recorded game, in one pass over the words of the board. Every press counts as a move. The presses are not journalled one by one, so the moves made before cannot be undone afterwards. The return value is the number of presses.
+ * @param presses The press pattern, getPressWords() words in the layout of the board: for a board packed in one word, the cell (x, y) in the bit (x-1)*nPoints + (y-1); for a large board, one row after the other, the cell (x, y) in the bit (y-1)%64 of the word (y-1)/64 of its row.
+ */
+int64_t Blackout::applyPresses (const uint64_t *presses)
+{
+  ScopedTimer timer (OP_APPLY_PRESSES);
+  int64_t nPresses = (int64_t) popCountWords (presses, this->b->getStateWords ());
+
+  this->b->applyPressPattern (presses);
+  this->journal->clear ();
+  this->nMoves += (int) nPresses;
+  if (this->solutionKnown && this->movesRemaining >= 0)
+    {
+      for (size_t i=0; i<this->solution.size (); i++)
+	{
+	  this->solution[i] ^= presses[i];
+	}
+      this->movesRemaining = (int64_t) popCountWords (&this->solution[0], this->solution.size ());
+    }
+  INSTRUMENT_COUNT (COUNT_MOVES, (uint64_t) nPresses);
+  return (nPresses);
+}
+
+/**
+ * Returns whether a press pattern wins the game from the current state. The pattern is applied, the win condition is checked and the pattern is applied again, which restores the board, so no copy of the board is made.
+ * @param presses The press pattern, in the layout of applyPresses.
+ */
+bool Blackout::isSolution (const uint64_t *presses)
+{
+  int64_t boardSum;
+
+  this->b->applyPressPattern (presses);
+  boardSum = this->b->sum ();
+  this->b->applyPressPattern (presses);
+  return ((boardSum==0) || (boardSum==((int64_t) this->nPoints * this->nPoints)));
+}
+
+/**
+ * Returns the number of 64-bit words of a press pattern for this board.
+ */
+size_t Blackout::getPressWords ()
+{
+  return (this->b->getStateWords ());
+}
+
+/**
+ * Finds the next cell to press to win the game, the first cell in reading order of a solution of the current state. The solution is kept up to date by every move, so it is only searched after a new, generated or loaded game, a reset or a flipped cell. The return value is false if the game is won, or its state cannot be solved.
+ * @param x Pointer to the location where the row number of the cell is copied.
+ * @param y Pointer to the location where the column number of the cell is copied.
+ */
+bool Blackout::getHint (int *x, int *y)
+{
+  size_t word, rowWords;
+  int bit;
+
+  this->findSolution ();
+  if (this->movesRemaining <= 0)
     {
-      this->flipCell (x-1, y);
+      return (false);
     }
-  // Flip below
-  if (x!=this->nPoints)
+
+  for (word=0; this->solution[word]==0; word++)
+    ;
+  for (bit=0; !((this->solution[word] >> bit) & 1); bit++)
+    ;
+
+  if (this->b->isLarge ())
     {
-      this->flipCell (x+1, y);
+      rowWords = (this->nPoints + 63) / 64;
+      *x = (int) (word / rowWords) + 1;
+      *y = (int) (word % rowWords) * 64 + bit + 1;
     }
-  // Flip left
-  if (y!=1)
+  else
+    {
+      *x = bit / this->nPoints + 1;
+      *y = bit % this->nPoints + 1;
+    }
+  return (true);
+}
+
+/**
+ * Returns the number of presses of the solution kept for the current state, or -1 if the state cannot be solved. For a board packed in one word the solution has the fewest presses when it is found, and keeps the fewest while the player follows the hints.
+ */
+int64_t Blackout::getMovesRemaining ()
+{
+  this->findSolution ();
+  return (this->movesRemaining);
+}
+
+/**
+ * Solves the current state into solution, unless solutionKnown is set. A board packed in one word is solved with the fewest presses.
+ */
+void Blackout::findSolution ()
+{
+  if (this->solutionKnown)
+    {
+      return;
+    }
+
+  this->solution.assign (this->b->getStateWords (), 0);
+  if (this->solve (&this->solution[0], SOLVE_OPTIMAL))
     {
-      this->flipCell (x, y-1);
+      this->movesRemaining = (int64_t) popCountWords (&this->solution[0], this->solution.size ());
     }
-  // Flip right
-  if (y!=this->nPoints)
+  else
     {
-      this->flipCell (x, y+1);
+      this->movesRemaining = -1;
     }
+  this->solutionKnown = true;
+}
 
+/**
+ * Flips the press of the cell (x, y) in the known solution, after a press of that cell.
+ * @param x Row number of the cell pressed.
+ * @param y Column number of the cell pressed.
+ */
+void Blackout::togglePress (int x, int y)
+{
+  size_t word;
+  uint64_t bit;
+
+  // An unsolvable state stays unsolvable whatever is pressed
+  if (!this->solutionKnown || this->movesRemaining < 0)
+    {
+      return;
+    }
+
+  if (this->b->isLarge ())
+    {
+      word = (size_t) (x-1) * ((this->nPoints + 63) / 64) + (y-1) / 64;
+      bit = ((uint64_t) 1) << ((y-1) % 64);
+    }
+  else
+    {
+      word = 0;
+      bit = ((uint64_t) 1) << ((x-1) * this->nPoints + (y-1));
+    }
+
+  this->solution[word] ^= bit;
+  this->movesRemaining += (this->solution[word] & bit) ? 1 : -1;
+}
+
+/**
+ * Undoes the last move by pressing its cell again. The return value is false if there is no move to undo.
+ * @param x Pointer to the location where the row number of the cell pressed is copied, or NULL. Default value: NULL.
+ * @param y Pointer to the location where the column number of the cell pressed is copied, or NULL. Default value: NULL.
+ */
+bool Blackout::undo (int *x, int *y)
+{
+  uint32_t index;
+
+  if (!this->journal->undo (&index))
+    {
+      return (false);
+    }
+  this->b->pressCell (index / this->nPoints + 1, index % this->nPoints + 1);
+  this->togglePress (index / this->nPoints + 1, index % this->nPoints + 1);
+  (this->nMoves)--;
+  if (x && y)
+    {
+      *x = index / this->nPoints + 1;
+      *y = index % this->nPoints + 1;
+    }
+  return (true);
+}
+
+/**
+ * Redoes the last undone move. The return value is false if there is no move to redo.
+ * @param x Pointer to the location where the row number of the cell pressed is copied, or NULL. Default value: NULL.
+ * @param y Pointer to the location where the column number of the cell pressed is copied, or NULL. Default value: NULL.
+ */
+bool Blackout::redo (int *x, int *y)
+{
+  uint32_t index;
+
+  if (!this->journal->redo (&index))
+    {
+      return (false);
+    }
+  this->b->pressCell (index / this->nPoints + 1, index % this->nPoints + 1);
+  this->togglePress (index / this->nPoints + 1, index % this->nPoints + 1);
   (this->nMoves)++;
+  if (x && y)
+    {
+      *x = index / this->nPoints + 1;
+      *y = index % this->nPoints + 1;
+    }
   return (true);
 }
 
 /**
- * Checks for the win condition - that is if the board is composed of only one kind of item, all 0's or all 1's.
+ * Checks for the win condition - that is if the board is composed of only one kind of item, all 0's or all 1's. The board keeps count of its lit cells as they change, so this is a comparison of that count with 0 and nPoints*nPoints.
  */
 bool Blackout::checkWinCondition ()
 {
-  int boardSum = this->b->sum ();
+  ScopedTimer timer (OP_WIN_CHECK);
+  INSTRUMENT_COUNT (COUNT_WIN_CHECKS, 1);
+  int64_t boardSum = this->b->sum ();
   // For the win condition, all cells must be 0 or 1
-  this->win = (boardSum==0) || (boardSum==(this->nPoints * this->nPoints));
+  this->win = (boardSum==0) || (boardSum==((int64_t) this->nPoints * this->nPoints));
   return ( this->win );
 }
 
 /**
- * This function generates a new game. THis is done by basically starting from a full square, and performing the number of moves specified by the nInitializationLoops variable, and taking the final state as the beginning of the game. This ensures that we get a 'solvable' puzzle.
- * @param nInitializationLoops Number of moves used initially carried out to jumble up the puzzle. Default value: DEFAULT_INITIALIZATION_LOOPS.
+ * This function generates a new game. A random set of presses, each cell pressed or not with equal probability, is applied to the empty board in one pass. Every solvable state is the result of exactly as many press sets as any other, so the game is drawn uniformly from the solvable states. A state that is already won is drawn again, up to maxAttempts times in all. A large board is generated the same way, one random word of presses per 64 cells of a row, applied as one press pattern.
+ * @param maxAttempts Number of states drawn before giving up. Default value: GAME_GENERATION_ATTEMPTS.
  */
-bool Blackout::generateGame (int nInitializationLoops, int count)
+bool Blackout::generateGame (int maxAttempts)
 {
-  int x, y, i;
-
-  srand ( time (NULL) );  // Set the seed for the random number generation
+  ScopedTimer timer (OP_GENERATE);
+  int attempt, x, word, rowWords = (this->nPoints + 63) / 64;
+  uint64_t presses;
+  std::vector<uint64_t> pattern;
 
-  for (i=0; i<nInitializationLoops; i++)
+  // The random presses come from the generator of the calling thread, see seedRandomGenerator for reproducible games
+  for (attempt=0; attempt<maxAttempts; attempt++)
     {
-      // Get random position on the board
-      x = getRandomInteger (1, this->nPoints);
-      y = getRandomInteger (1, this->nPoints);
-
-      if (!this->applyMove (x, y))
+      if (attempt)
 	{
-	  // Trouble applying move. Abort.
-	  return (false);
+	  INSTRUMENT_COUNT (COUNT_GENERATION_RETRIES, 1);
+	}
+      this->b->setState (0);
+      if (this->b->isLarge ())
+	{
+	  // One random word of presses per 64 cells, with the bits past the end of each row cleared
+	  pattern.resize (this->b->getStateWords ());
+	  for (x=0; x<this->nPoints; x++)
+	    {
+	      for (word=0; word<rowWords; word++)
+		{
+		  pattern[(size_t) x * rowWords + word] = getRandomWord ();
+		}
+	      if (this->nPoints % 64)
+		{
+		  pattern[(size_t) x * rowWords + rowWords-1] &= (((uint64_t) 1) << (this->nPoints % 64)) - 1;
+		}
+	    }
+	  this->b->applyPressPattern (&pattern[0]);
+	}
+      else
+	{
+	  presses = getRandomWord () & this->b->getBoardMask ();
+	  this->b->pressCells (presses);
 	}
-    }
 
-  // Check for not getting a winning condition right at the beginning.
-  // Because that would be just plain absurd, won't it?
-  if (this->checkWinCondition())
-    {
-      // This is not working. Game generation failed
-      if (count==GAME_RECURSION_LIMIT)
+      // Check for not getting a winning condition right at the beginning.
+      // Because that would be just plain absurd, won't it?
+      if (!this->checkWinCondition ())
 	{
-	  return (false);
+	  this->startGame ();
+	  return (true);
 	}
-      // Let's try generating with a different number of initialization loops
-      this->generateGame(nInitializationLoops * rand(), ++count);
     }
 
-  // If we reach here, then the game generation was successful
+  // This is not working. Game generation failed
+  return (false);
+}
+
+/**
+ * Starts a new game from the given state of the board, one bit per cell. The state becomes the initial state and the move count is cleared.
+ * @param state The state of the board, with the cell (x, y) in the bit (x-1)*nPoints + (y-1).
+ */
+void Blackout::newGame (uint64_t state)
+{
+  this->b->setState (state);
+  this->startGame ();
+}
+
+/**
+ * Makes the current state of the board the initial state of a new game, and clears the move count.
+ */
+void Blackout::startGame ()
+{
+  this->b->setInitialState ();
+  this->journal->clear ();
   this->nMoves = 0;
   this->win = false;
-  this->b->setInitialState ();
-  return (true);
+  this->solutionKnown = false;
 }
 
 /**
- * Saves the current state of the game to file.
+ * Saves the current state of the game to file. The save files do not record the rule of the moves, so only games of the plus rule are saved; the return value is false for any other rule.
  * @param fileName Name of the file to which the game is to be saved.
  */
 bool Blackout::saveGame (const char* fileName)
 {
+  ScopedTimer timer (OP_SAVE);
+
+  if (!this->b->getNeighbourhood ().isPlus ())
+    {
+      return (false);
+    }
+
   // Open the file
   std::ofstream outFile;
   outFile.open (fileName);
@@ -155,8 +448,8 @@ bool Blackout::saveGame (const char* fileName)
     {
       int i, j, cellValue;
 
-      outFile << "Board size: " << this->nPoints << std::endl;
-      outFile << "Moves: " << this->nMoves << std::endl;
+      outFile << "Board size: " << this->nPoints << "\n";
+      outFile << "Moves: " << this->nMoves << "\n";
 
       outFile << "Board state:";
       for (i=0; i<this->nPoints; i++)
@@ -179,9 +472,10 @@ bool Blackout::saveGame (const char* fileName)
 	      outFile << cellValue << " ";
 	    }
 	}
-      outFile << std::endl;
+      outFile << "\n";
+      INSTRUMENT_COUNT (COUNT_SAVE_BYTES, (uint64_t) outFile.tellp ());
       outFile.close ();
-      return (true);
+      return (!outFile.fail ());
     }
   else
     {
@@ -190,151 +484,214 @@ bool Blackout::saveGame (const char* fileName)
 }
 
 /**
- * Loads the game from a file.
+ * Loads the game from a file. The file is parsed in one pass through a fixed buffer, without allocating memory, and the cells are decoded straight into the bit layout of the board; a large board is decoded into a new board, which replaces the current one once the whole file is read. The return value is false, and the game is left unchanged, if the file cannot be read, is malformed or holds a board of a different size, or if the game is not of the plus rule, the only rule of the save files.
  * @param fileName File of the file from which to load the game.
  */
 bool Blackout::loadGame (const char* fileName)
 {
-  // Open the file
-  std::ifstream inFile;
-  inFile.open (fileName);
-
-  if (inFile.is_open())
-    {
-      // Before the file data is read directly into the class object, it must be verified.
-      // The following variables store temporarily until all information in the file is read.
-      int boardSize, numMoves;
-      int **boardData;
-      int i, j;
-
-      std::string t1, t2;    // To store the titles
-      std::string line;      // To read entire lines
-      // char newline;
-      inFile >> t1 >> t2 >> boardSize;   // Board size:
-      inFile >> t1 >> numMoves;          // Moves:
-
-      // Read current board state
-      std::getline (inFile, line);       // Newline
-      std::getline (inFile, line);       // Board state:
-
-      // Allocate memory to boardData
-      boardData = new int* [boardSize];
-      if (!boardData)
+  ScopedTimer timer (OP_LOAD);
+  FILE *inFile;
+
+  if (!this->b->getNeighbourhood ().isPlus ())
+    {
+      return (false);
+    }
+  inFile = fopen (fileName, "r");
+  if (!inFile)
+    {
+      return (false);
+    }
+
+  TextReader reader (inFile);
+  int boardSize, numMoves, value;
+  int64_t i, nCells = (int64_t) this->nPoints * this->nPoints;
+  uint64_t state = 0, initialState = 0;
+  Board *loaded = NULL;
+  bool valid;
+
+  // Board size: <n>
+  valid = reader.expect ("Board") && reader.expect ("size:") && reader.nextInteger (&boardSize) && boardSize == this->nPoints;
+  // Moves: <m>
+  valid = valid && reader.expect ("Moves:") && reader.nextInteger (&numMoves) && numMoves >= 0;
+
+  // Board state: followed by the cells row after row
+  valid = valid && reader.expect ("Board") && reader.expect ("state:");
+  if (valid && this->b->isLarge ())
+    {
+      loaded = new Board (this->nPoints);
+    }
+  for (i=0; valid && i<nCells; i++)
+    {
+      valid = reader.nextBit (&value);
+      if (!valid)
 	{
-	  return (false);
+	  break;
+	}
+      if (loaded)
+	{
+	  loaded->setCellValue ((int) (i / this->nPoints) + 1, (int) (i % this->nPoints) + 1, value);
 	}
       else
 	{
-	  for (i=0; i<boardSize; i++)
-	    {
-	      boardData[i] = new int [boardSize];
-	      if (!boardData[i])
-		{
-		  // Clear previous data
-		  for (j=0; i<i; j++)
-		    {
-		      delete (boardData[j]);
-		      boardData[j] = NULL;
-		    }
-		  delete (boardData);
-		  boardData = NULL;
-
-		  inFile.close ();
-		  return (false);
-		}
-	      else
-		{
-		  // Data allocation done - populate the array
-		  for (j=0; j<boardSize; j++)
-		    {
-		      inFile >> boardData[i][j];
-		    }
-		  // inFile >> newline;
-		}
-	    }
-	  // All data is read - it can be transferred now
-	  for (i=0; i<boardSize; i++)
-	    {
-	      for (j=0; j<boardSize; j++)
-		{
-		  this->b->setCellValue(i+1, j+1, boardData[i][j]);
-		}
-	    }
-	  // Free data from boardData
-	  for (i=0; i<boardSize; i++)
-	    {
-	      delete (boardData[i]);
-	      boardData[i] = NULL;
-	    }
-	  delete (boardData);
-	  boardData = NULL;
+	  state |= ((uint64_t) value) << i;
 	}
+    }
 
-      // Read initial board state
-      std::getline (inFile, line);      // Newline
-      std::getline (inFile, line);      // Initial state:
-
-      // Allocate memory to boardData
-      boardData = new int* [boardSize];
-      if (!boardData)
+  // Initial state: followed by the cells row after row
+  valid = valid && reader.expect ("Initial") && reader.expect ("state:");
+  for (i=0; valid && i<nCells; i++)
+    {
+      valid = reader.nextBit (&value);
+      if (!valid)
 	{
-	  return (false);
+	  break;
+	}
+      if (loaded)
+	{
+	  loaded->setInitialCellValue ((int) (i / this->nPoints) + 1, (int) (i % this->nPoints) + 1, value);
 	}
       else
 	{
-	  for (i=0; i<boardSize; i++)
-	    {
-	      boardData[i] = new int [boardSize];
-	      if (!boardData[i])
-		{
-		  // Clear previous data
-		  for (j=0; i<i; j++)
-		    {
-		      delete (boardData[j]);
-		      boardData[j] = NULL;
-		    }
-		  delete (boardData);
-		  boardData = NULL;
-
-		  inFile.close ();
-		  return (false);
-		}
-	      else
-		{
-		  // Data allocation done - populate the array
-		  for (j=0; j<boardSize; j++)
-		    {
-		      inFile >> boardData[i][j];
-		    }
-		  // inFile >> newline;
-		}
-	    }
-	  // All data is read - it can be transferred now
-	  for (i=0; i<boardSize; i++)
-	    {
-	      for (j=0; j<boardSize; j++)
-		{
-		  this->b->setInitialCellValue(i+1, j+1, boardData[i][j]);
-		}
-	    }
-	  // Free data from boardData
-	  for (i=0; i<boardSize; i++)
-	    {
-	      delete (boardData[i]);
-	      boardData[i] = NULL;
-	    }
-	  delete (boardData);
-	  boardData = NULL;
+	  initialState |= ((uint64_t) value) << i;
 	}
+    }
 
-      // All data is read - close the file and return
-      inFile.close ();      
-      return (true);
+  valid = valid && reader.atEnd ();
+  INSTRUMENT_COUNT (COUNT_LOAD_BYTES, (uint64_t) ftell (inFile));
+  fclose (inFile);
+
+  if (!valid)
+    {
+      delete (loaded);
+      return (false);
+    }
+
+  // All data is read and verified - it can be transferred now
+  if (loaded)
+    {
+      delete (this->b);
+      this->b = loaded;
+      this->journal->clear ();
+      this->win = false;
+      this->solutionKnown = false;
     }
   else
+    {
+      this->newGame (initialState);
+      this->b->setState (state);
+    }
+  this->nMoves = numMoves;
+  this->checkWinCondition ();
+  return (true);
+}
+
+/**
+ * Saves the current state of the game to file in the binary format, with a single write. The file holds, in little-endian order:
+ * bytes 0-3: BINARY_SAVE_MAGIC, byte 4: BINARY_SAVE_VERSION, byte 5: board size, bytes 6-7: 0, bytes 8-11: number of moves, bytes 12-15: checksum32 of the file with these bytes set to 0, bytes 16-23: current state, bytes 24-31: initial state. The states have one bit per cell, the cell (x, y) in the bit (x-1)*nPoints + (y-1). Large boards have no binary format, and the format does not record the rule of the moves, so the return value is always false for large boards and for rules other than plus.
+ * @param fileName Name of the file to which the game is to be saved.
+ */
+bool Blackout::saveGameBinary (const char* fileName)
+{
+  ScopedTimer timer (OP_SAVE);
+  unsigned char buffer[BINARY_SAVE_SIZE];
+  int i;
+
+  if (this->b->isLarge () || !this->b->getNeighbourhood ().isPlus ())
+    {
+      return (false);
+    }
+
+  for (i=0; i<BINARY_SAVE_SIZE; i++)
+    {
+      buffer[i] = 0;
+    }
+  for (i=0; i<4; i++)
+    {
+      buffer[i] = (unsigned char) BINARY_SAVE_MAGIC[i];
+    }
+  buffer[4] = BINARY_SAVE_VERSION;
+  buffer[5] = (unsigned char) this->nPoints;
+  storeLittleEndian (buffer + 8, (uint64_t) this->nMoves, 4);
+  storeLittleEndian (buffer + 16, this->b->getState (), 8);
+  storeLittleEndian (buffer + 24, this->b->getInitialState (), 8);
+  storeLittleEndian (buffer + 12, checksum32 (buffer, BINARY_SAVE_SIZE), 4);
+
+  std::ofstream outFile (fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!outFile.is_open())
     {
       return (false);
     }
+  outFile.write ((const char *) buffer, BINARY_SAVE_SIZE);
+  INSTRUMENT_COUNT (COUNT_SAVE_BYTES, BINARY_SAVE_SIZE);
+  outFile.close ();
+  return (!outFile.fail ());
+}
+
+/**
+ * Loads the game from a file in the binary format written by saveGameBinary, with a single read. The return value is false if the file cannot be read, is not in the binary format, fails its checksum, holds a board of a different size or a number of moves above INT_MAX, or if the game is not of the plus rule. Large boards have no binary format, so the return value is always false for them.
+ * @param fileName File of the file from which to load the game.
+ */
+bool Blackout::loadGameBinary (const char* fileName)
+{
+  ScopedTimer timer (OP_LOAD);
+  unsigned char buffer[BINARY_SAVE_SIZE];
+  uint32_t checksum;
+  uint64_t state, initialState, numMoves;
+  int i;
+
+  if (this->b->isLarge () || !this->b->getNeighbourhood ().isPlus ())
+    {
+      return (false);
+    }
+
+  std::ifstream inFile (fileName, std::ios::in | std::ios::binary);
+  if (!inFile.is_open())
+    {
+      return (false);
+    }
+  inFile.read ((char *) buffer, BINARY_SAVE_SIZE);
+  INSTRUMENT_COUNT (COUNT_LOAD_BYTES, (uint64_t) inFile.gcount ());
+  if (inFile.gcount () != BINARY_SAVE_SIZE)
+    {
+      return (false);
+    }
+  inFile.close ();
+
+  // Verify the header before anything is changed
+  for (i=0; i<4; i++)
+    {
+      if (buffer[i] != (unsigned char) BINARY_SAVE_MAGIC[i])
+	{
+	  return (false);
+	}
+    }
+  if (buffer[4] != BINARY_SAVE_VERSION || buffer[5] != this->nPoints)
+    {
+      return (false);
+    }
+  checksum = (uint32_t) loadLittleEndian (buffer + 12, 4);
+  storeLittleEndian (buffer + 12, 0, 4);
+  if (checksum != checksum32 (buffer, BINARY_SAVE_SIZE))
+    {
+      return (false);
+    }
+  state = loadLittleEndian (buffer + 16, 8);
+  initialState = loadLittleEndian (buffer + 24, 8);
+  if ((state | initialState) & ~this->b->getBoardMask ())
+    {
+      return (false);
+    }
+  numMoves = loadLittleEndian (buffer + 8, 4);
+  if (numMoves > INT_MAX)
+    {
+      return (false);
+    }
+
+  this->newGame (initialState);
+  this->b->setState (state);
+  this->nMoves = (int) numMoves;
+  this->checkWinCondition ();
+  return (true);
 }
 
 /**
@@ -343,7 +700,9 @@ bool Blackout::loadGame (const char* fileName)
 void Blackout::reset ()
 {
   this->b->resetBoard ();
+  this->journal->clear ();
   this->nMoves = 0;
+  this->solutionKnown = false;
 }
 
 /**
@@ -353,17 +712,90 @@ void Blackout::reset ()
  */
 void Blackout::flipCell (int x, int y)
 {
-  int cellValue;
-  this->b->getCellValue (x, y, &cellValue);
+  ScopedTimer timer (OP_FLIP_CELL);
+  INSTRUMENT_COUNT (COUNT_FLIPS, 1);
+  this->b->flipCell (x, y);
+  this->solutionKnown = false;
+}
+
+/**
+ * Finds the set of cells to press, from the current state of the board, to reach a winning state (all 0's or all 1's). The cell (x, y) is the bit (x-1)*nPoints + (y-1) of the set. A large board is solved by its LargeSolver, whatever the method, and the set is a press pattern of getPressWords() words. The return value is false if the current state cannot be solved, or the board is larger than LARGE_SOLVER_MAX_SIZE.
+ * @param presses Pointer to the location where the set of cells to press is copied, of getPressWords() words.
+ * @param method The method used to solve the board. Default value: SOLVE_CHASE.
+ */
+bool Blackout::solve (uint64_t *presses, SolverMethod method)
+{
+  ScopedTimer timer (OP_SOLVE);
+  uint64_t state = this->b->getState ();
+  uint64_t toOn;
+  bool offSolved, onSolved;
 
-  if (cellValue==0)
+  if (this->b->isLarge ())
     {
-      this->b->setCellValue (x, y, 1);
+      LargeSolver *largeSolver = LargeSolver::forSize (this->nPoints);
+      if (!largeSolver)
+	{
+	  return (false);
+	}
+      std::vector<uint64_t> words (this->b->getStateWords ());
+      this->b->snapshot (words.data ());
+      return (largeSolver->solve (words.data (), presses) || largeSolver->solve (words.data (), presses, true));
     }
-  else
+
+  if (!this->solver)
+    {
+      return (false);
+    }
+
+  if (method == SOLVE_OPTIMAL)
+    {
+      // Either win state may need fewer moves, so both are solved
+      offSolved = this->solver->solve (state, presses, method);
+      onSolved = this->solver->solve (state ^ this->b->getBoardMask (), &toOn, method);
+      if (onSolved && (!offSolved || popCount (toOn) < popCount (*presses)))
+	{
+	  *presses = toOn;
+	}
+      return (offSolved || onSolved);
+    }
+
+  // Try to switch every cell off, and failing that, to switch every cell on
+  if (this->solver->solve (state, presses, method))
     {
-      this->b->setCellValue (x, y, 0);
+      return (true);
     }
+  return (this->solver->solve (state ^ this->b->getBoardMask (), presses, method));
+}
+
+/**
+ * Returns the fewest moves needed to win the game from its initial state, or -1 if the initial state cannot be solved or the board is large. This is the score against which the player's number of moves is measured.
+ */
+int Blackout::getOptimalMoves ()
+{
+  uint64_t state = this->b->getInitialState ();
+  uint64_t toOff, toOn;
+  bool offSolved, onSolved;
+
+  if (!this->solver)
+    {
+      return (-1);
+    }
+
+  offSolved = this->solver->solveOptimal (state, &toOff);
+  onSolved = this->solver->solveOptimal (state ^ this->b->getBoardMask (), &toOn);
+  if (offSolved && onSolved)
+    {
+      return (popCount (toOff) < popCount (toOn) ? popCount (toOff) : popCount (toOn));
+    }
+  if (offSolved)
+    {
+      return (popCount (toOff));
+    }
+  if (onSolved)
+    {
+      return (popCount (toOn));
+    }
+  return (-1);
 }
 
 /**
@@ -394,6 +826,58 @@ bool Blackout::show ()
   return (true);
 }
 
+/**
+ * Returns the length of the side of the board.
+ */
+int Blackout::getSize ()
+{
+  return (this->nPoints);
+}
+
+/**
+ * Returns the rule of the moves of the game.
+ */
+const Neighbourhood &Blackout::getNeighbourhood ()
+{
+  return (this->b->getNeighbourhood ());
+}
+
+/**
+ * Returns in the pointer value the value of the cell at (x, y). If the co-ordinates are valid, the return is true, else false.
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ * @param value Pointer to the location in memory where the value of the cell is copied.
+ */
+bool Blackout::getCellValue (int x, int y, int *value)
+{
+  return (this->b->getCellValue (x, y, value));
+}
+
+/**
+ * Returns the current state of the board, one bit per cell as in Board::getState.
+ */
+uint64_t Blackout::getState ()
+{
+  return (this->b->getState ());
+}
+
+/**
+ * Returns the state of the board at the start of the game, one bit per cell as in Board::getState.
+ */
+uint64_t Blackout::getInitialState ()
+{
+  return (this->b->getInitialState ());
+}
+
+/**
+ * Copies the current state of the board to words, which holds getPressWords() words, in the layout of Board::snapshot. The copy can be solved on another thread while the game goes on.
+ * @param words Pointer to the location where the state is copied.
+ */
+void Blackout::snapshot (uint64_t *words)
+{
+  this->b->snapshot (words);
+}
+
 /**
  * Returns the number of moves carried out.
  */
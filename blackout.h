@@ -32,25 +32,59 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
 #include <time.h>
+#include <limits.h>
 
 #include "tools.h"
 #include "board.h"
-
-#ifndef DEFAULT_INITIALIZATION_LOOPS
-#define DEFAULT_INITIALIZATION_LOOPS 20
-#endif
+#include "solver.h"
+#include "largeSolver.h"
+#include "textReader.h"
+#include "moveJournal.h"
+#include "instrumentation.h"
 
 #ifndef DEFAULT_GAMESQUARESIZE
 #define DEFAULT_GAMESQUARESIZE 3
 #endif
 
+/**
+ * The largest board of the text game and of the puzzle tools. Larger boards, up to MAX_LARGE_BOARDSIZE, are large boards: they can be played, generated, saved and loaded in the text format, and are solved by LargeSolver up to LARGE_SOLVER_MAX_SIZE, but they have no binary format.
+ */
 #ifndef MAX_GAMESQUARESIZE
 #define MAX_GAMESQUARESIZE 8
 #endif
 
-#ifndef GAME_RECURSION_LIMIT
-#define GAME_RECURSION_LIMIT 10
+/**
+ * The binary save file starts with these 4 bytes.
+ */
+#ifndef BINARY_SAVE_MAGIC
+#define BINARY_SAVE_MAGIC "BKO\x1A"
+#endif
+
+/**
+ * Version of the binary save format written by saveGameBinary.
+ */
+#ifndef BINARY_SAVE_VERSION
+#define BINARY_SAVE_VERSION 1
+#endif
+
+/**
+ * Size in bytes of a binary save file.
+ */
+#ifndef BINARY_SAVE_SIZE
+#define BINARY_SAVE_SIZE 32
+#endif
+
+/**
+ * Files with this extension are saved and loaded in the binary format by the game manager.
+ */
+#ifndef BINARY_SAVE_EXTENSION
+#define BINARY_SAVE_EXTENSION ".bko"
+#endif
+
+#ifndef GAME_GENERATION_ATTEMPTS
+#define GAME_GENERATION_ATTEMPTS 10
 #endif
 
 /**
@@ -63,6 +97,14 @@ class Blackout
    * The board on wich the game is played.
    */
   Board *b;
+  /**
+   * Solver for the board of this game. It is shared by all games with the same board size.
+   */
+  Solver *solver;
+  /**
+   * The moves made since the game started, for undo and redo.
+   */
+  MoveJournal *journal;
   /**
    * Keeps count of the number of moves.
    */
@@ -79,20 +121,72 @@ class Blackout
    *
    */
   bool win;
+  /**
+   * A set of presses that wins the game from the current state, in the layout of applyPresses. Presses commute and every press is its own inverse, so a move at a cell only flips the bit of that cell in the set. It is valid only while solutionKnown is set.
+   */
+  std::vector<uint64_t> solution;
+  /**
+   * Set while solution and movesRemaining hold for the current state. It is cleared when the state changes other than by presses: a new, generated or loaded game, a reset or a flipped cell.
+   */
+  bool solutionKnown;
+  /**
+   * Number of presses in solution, or -1 if the current state cannot be solved.
+   */
+  int64_t movesRemaining;
+
+  /**
+   * Makes the current state of the board the initial state of a new game, and clears the move count.
+   */
+  void startGame ();
+  /**
+   * Solves the current state into solution, unless solutionKnown is set. A board packed in one word is solved with the fewest presses.
+   */
+  void findSolution ();
+  /**
+   * Flips the press of the cell (x, y) in the known solution, after a press of that cell.
+   * @param x Row number of the cell pressed.
+   * @param y Column number of the cell pressed.
+   */
+  void togglePress (int x, int y);
+  /**
+   * Games are not copied: a copy would share, and free a second time, the board and the journal.
+   */
+  Blackout (const Blackout &game);
+  /**
+   * Games are not assigned: an assignment would share, and free a second time, the board and the journal.
+   */
+  Blackout &operator= (const Blackout &game);
 
  public:
     /**
      * Constructor that initializes the game.
+     * @param boardSize The side of the board. Default value: DEFAULT_GAMESQUARESIZE.
+     * @param rule The cells flipped by a move, ignored on a large board. Default value: the plus rule.
      */
-    Blackout (int boardSize=DEFAULT_GAMESQUARESIZE);
+    Blackout (int boardSize=DEFAULT_GAMESQUARESIZE, const Neighbourhood &rule=Neighbourhood ());
     /**
-     * This function generates a new game. THis is done by basically starting from a full square, and performing the number of moves specified by the nInitializationLoops variable, and taking the final state as the beginning of the game. This ensures that we get a 'solvable' puzzle.
-     * @param nInitializationLoops Number of moves used initially carried out to jumble up the puzzle. Default value: DEFAULT_INITIALIZATION_LOOPS.
-     * @param count Counts the number of recursions.
+     * Destructor that frees the board.
      */
-    bool generateGame (int nInitializationLoops=DEFAULT_INITIALIZATION_LOOPS, int count=0);
+    ~Blackout ();
     /**
-     * Checks for the win condition - that is if the board is composed of only one kind of item, all 0's or all 1's.
+     * Builds a game of the size recorded in a save file and loads the file into it, so that a saved game of any size can be loaded without knowing its size beforehand. The size is checked against maxSize and against the length of the file before the game is built. The return value is the new game, to be freed by the caller, or NULL if the file cannot be read, is not a save of a game of the plus rule, or records a size above maxSize or too large for its length.
+     * @param fileName Name of the file from which to load the game.
+     * @param binary Whether the file is in the binary format of saveGameBinary rather than the text format of saveGame.
+     * @param maxSize The largest side accepted. Default value: MAX_LARGE_BOARDSIZE.
+     */
+    static Blackout *fromFile (const char *fileName, bool binary, int maxSize=MAX_LARGE_BOARDSIZE);
+    /**
+     * This function generates a new game. A random set of presses, each cell pressed or not with equal probability, is applied to the empty board in one pass. Every solvable state is the result of exactly as many press sets as any other, so the game is drawn uniformly from the solvable states. A state that is already won is drawn again, up to maxAttempts times in all. A large board is generated the same way, one random word of presses per 64 cells of a row, applied as one press pattern.
+     * @param maxAttempts Number of states drawn before giving up. Default value: GAME_GENERATION_ATTEMPTS.
+     */
+    bool generateGame (int maxAttempts=GAME_GENERATION_ATTEMPTS);
+    /**
+     * Starts a new game from the given state of the board, one bit per cell. The state becomes the initial state and the move count is cleared.
+     * @param state The state of the board, with the cell (x, y) in the bit (x-1)*nPoints + (y-1).
+     */
+    void newGame (uint64_t state);
+    /**
+     * Checks for the win condition - that is if the board is composed of only one kind of item, all 0's or all 1's. The board keeps count of its lit cells as they change, so this is a comparison of that count with 0 and nPoints*nPoints.
      */
     bool checkWinCondition ();
     /**
@@ -102,15 +196,62 @@ class Blackout
      */
     bool applyMove (int x, int y);
     /**
-     * Saves the current state of the game to file.
+     * Presses every cell set in a press pattern at once, for instance a solution or a recorded game, in one pass over the words of the board. Every press counts as a move. The presses are not journalled one by one, so the moves made before cannot be undone afterwards. The return value is the number of presses.
+     * @param presses The press pattern, getPressWords() words in the layout of the board: for a board packed in one word, the cell (x, y) in the bit (x-1)*nPoints + (y-1); for a large board, one row after the other, the cell (x, y) in the bit (y-1)%64 of the word (y-1)/64 of its row.
+     */
+    int64_t applyPresses (const uint64_t *presses);
+    /**
+     * Returns whether a press pattern wins the game from the current state. The pattern is applied, the win condition is checked and the pattern is applied again, which restores the board, so no copy of the board is made.
+     * @param presses The press pattern, in the layout of applyPresses.
+     */
+    bool isSolution (const uint64_t *presses);
+    /**
+     * Returns the number of 64-bit words of a press pattern for this board.
+     */
+    size_t getPressWords ();
+    /**
+     * Finds the next cell to press to win the game, the first cell in reading order of a solution of the current state. The solution is kept up to date by every move, so it is only searched after a new, generated or loaded game, a reset or a flipped cell. The return value is false if the game is won, or its state cannot be solved.
+     * @param x Pointer to the location where the row number of the cell is copied.
+     * @param y Pointer to the location where the column number of the cell is copied.
+     */
+    bool getHint (int *x, int *y);
+    /**
+     * Returns the number of presses of the solution kept for the current state, or -1 if the state cannot be solved. For a board packed in one word the solution has the fewest presses when it is found, and keeps the fewest while the player follows the hints.
+     */
+    int64_t getMovesRemaining ();
+    /**
+     * Undoes the last move by pressing its cell again. The return value is false if there is no move to undo.
+     * @param x Pointer to the location where the row number of the cell pressed is copied, or NULL. Default value: NULL.
+     * @param y Pointer to the location where the column number of the cell pressed is copied, or NULL. Default value: NULL.
+     */
+    bool undo (int *x=NULL, int *y=NULL);
+    /**
+     * Redoes the last undone move. The return value is false if there is no move to redo.
+     * @param x Pointer to the location where the row number of the cell pressed is copied, or NULL. Default value: NULL.
+     * @param y Pointer to the location where the column number of the cell pressed is copied, or NULL. Default value: NULL.
+     */
+    bool redo (int *x=NULL, int *y=NULL);
+    /**
+     * Saves the current state of the game to file. The save files do not record the rule of the moves, so only games of the plus rule are saved; the return value is false for any other rule.
      * @param fileName Name of the file to which the game is to be saved.
      */
     bool saveGame (const char* fileName);
     /**
-     * Loads the game from a file.
+     * Loads the game from a file. The file is parsed in one pass through a fixed buffer, without allocating memory, and the cells are decoded straight into the bit layout of the board; a large board is decoded into a new board, which replaces the current one once the whole file is read. The return value is false, and the game is left unchanged, if the file cannot be read, is malformed or holds a board of a different size, or if the game is not of the plus rule, the only rule of the save files.
      * @param fileName File of the file from which to load the game.
      */
     bool loadGame (const char* fileName);
+    /**
+     * Saves the current state of the game to file in the binary format, with a single write. The file holds, in little-endian order:
+     * bytes 0-3: BINARY_SAVE_MAGIC, byte 4: BINARY_SAVE_VERSION, byte 5: board size, bytes 6-7: 0, bytes 8-11: number of moves, bytes 12-15: checksum32 of the file with these bytes set to 0, bytes 16-23: current state, bytes 24-31: initial state. The states have one bit per cell, the cell (x, y) in the bit (x-1)*nPoints + (y-1). Large boards have no binary format, and the format does not record the rule of the moves, so the return value is always false for large boards and for rules other than plus.
+     * @param fileName Name of the file to which the game is to be saved.
+     */
+    bool saveGameBinary (const char* fileName);
+    /**
+     * Loads the game from a file in the binary format written by saveGameBinary, with a single read. The return value is false if the file cannot be read, is not in the binary format, fails its checksum, holds a board of a different size or a number of moves above INT_MAX, or if the game is not of the plus rule. Large boards have no binary format, so the return value is always false for them.
+     * @param fileName File of the file from which to load the game.
+     */
+    bool loadGameBinary (const char* fileName);
     /**
      * Resets the game to its initial state.
      */
@@ -121,10 +262,48 @@ class Blackout
      * @param y Column number of the point where the move is carried out.
      */
     void flipCell (int x, int y);
+    /**
+     * Finds the set of cells to press, from the current state of the board, to reach a winning state (all 0's or all 1's). The cell (x, y) is the bit (x-1)*nPoints + (y-1) of the set. A large board is solved by its LargeSolver, whatever the method, and the set is a press pattern of getPressWords() words. The return value is false if the current state cannot be solved, or the board is larger than LARGE_SOLVER_MAX_SIZE.
+     * @param presses Pointer to the location where the set of cells to press is copied, of getPressWords() words.
+     * @param method The method used to solve the board. Default value: SOLVE_CHASE.
+     */
+    bool solve (uint64_t *presses, SolverMethod method=SOLVE_CHASE);
+    /**
+     * Returns the fewest moves needed to win the game from its initial state, or -1 if the initial state cannot be solved or the board is large. This is the score against which the player's number of moves is measured.
+     */
+    int getOptimalMoves ();
     /**
      * Displays the game board.
      */
     bool show ();
+    /**
+     * Returns the length of the side of the board.
+     */
+    int getSize ();
+    /**
+     * Returns the rule of the moves of the game.
+     */
+    const Neighbourhood &getNeighbourhood ();
+    /**
+     * Returns in the pointer value the value of the cell at (x, y). If the co-ordinates are valid, the return is true, else false.
+     * @param x Row number of the cell.
+     * @param y Column number of the cell.
+     * @param value Pointer to the location in memory where the value of the cell is copied.
+     */
+    bool getCellValue (int x, int y, int *value);
+    /**
+     * Returns the current state of the board, one bit per cell as in Board::getState.
+     */
+    uint64_t getState ();
+    /**
+     * Returns the state of the board at the start of the game, one bit per cell as in Board::getState.
+     */
+    uint64_t getInitialState ();
+    /**
+     * Copies the current state of the board to words, which holds getPressWords() words, in the layout of Board::snapshot. The copy can be solved on another thread while the game goes on.
+     * @param words Pointer to the location where the state is copied.
+     */
+    void snapshot (uint64_t *words);
     /**
      * Returns the number of moves carried out.
      */
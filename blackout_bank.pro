@@ -0,0 +1,25 @@
+#-------------------------------------------------
+#
+# Command line builder of puzzle banks
+#
+#-------------------------------------------------
+
+QT       -= core gui
+
+TARGET = blackout_bank
+TEMPLATE = app
+
+CONFIG   += console c++11
+CONFIG   -= app_bundle qt
+
+
+SOURCES += bankMain.cpp \
+    puzzleBankWriter.cpp \
+    puzzleBank.cpp \
+    tools.cpp
+
+HEADERS  += puzzleBankWriter.h \
+    puzzleBank.h \
+    board.h \
+    neighbourhood.h \
+    tools.h
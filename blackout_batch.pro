@@ -0,0 +1,38 @@
+#-------------------------------------------------
+#
+# Command line generator of puzzle packs
+#
+#-------------------------------------------------
+
+QT       -= core gui
+
+TARGET = blackout_batch
+TEMPLATE = app
+
+CONFIG   += console c++11 thread
+CONFIG   -= app_bundle qt
+
+
+SOURCES += batchMain.cpp \
+    batchGenerator.cpp \
+    blackout.cpp \
+    solver.cpp \
+    largeSolver.cpp \
+    textReader.cpp \
+    moveJournal.cpp \
+    board.cpp \
+    neighbourhood.cpp \
+    tools.cpp \
+    instrumentation.cpp
+
+HEADERS  += batchGenerator.h \
+    blackout.h \
+    solver.h \
+    largeSolver.h \
+    textReader.h \
+    moveJournal.h \
+    board.h \
+    neighbourhood.h \
+    fixedBoard.h \
+    tools.h \
+    instrumentation.h
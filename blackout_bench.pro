@@ -0,0 +1,46 @@
+#-------------------------------------------------
+#
+# Microbenchmarks of the game engine
+#
+#-------------------------------------------------
+
+QT       -= core gui
+
+TARGET = blackout_bench
+TEMPLATE = app
+
+CONFIG   += console c++11 thread
+CONFIG   -= app_bundle qt
+
+
+SOURCES += benchMain.cpp \
+    benchmark.cpp \
+    multiBoard.cpp \
+    blackout.cpp \
+    solver.cpp \
+    largeSolver.cpp \
+    textReader.cpp \
+    moveJournal.cpp \
+    board.cpp \
+    neighbourhood.cpp \
+    modBoard.cpp \
+    modSolver.cpp \
+    modBlackout.cpp \
+    tools.cpp \
+    instrumentation.cpp
+
+HEADERS  += benchmark.h \
+    multiBoard.h \
+    blackout.h \
+    solver.h \
+    largeSolver.h \
+    textReader.h \
+    moveJournal.h \
+    board.h \
+    neighbourhood.h \
+    modBoard.h \
+    modSolver.h \
+    modBlackout.h \
+    fixedBoard.h \
+    tools.h \
+    instrumentation.h
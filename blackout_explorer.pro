@@ -0,0 +1,26 @@
+#-------------------------------------------------
+#
+# Command line explorer of the state space of small boards
+#
+#-------------------------------------------------
+
+QT       -= core gui
+
+TARGET = blackout_explorer
+TEMPLATE = app
+
+CONFIG   += console c++11 thread
+CONFIG   -= app_bundle qt
+
+
+SOURCES += explorerMain.cpp \
+    explorer.cpp \
+    board.cpp \
+    neighbourhood.cpp \
+    tools.cpp
+
+HEADERS  += explorer.h \
+    board.h \
+    neighbourhood.h \
+    fixedBoard.h \
+    tools.h
@@ -8,6 +8,8 @@ QT       += core gui
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
+CONFIG   += c++11 thread
+
 TARGET = blackout_gui
 TEMPLATE = app
 
@@ -17,12 +19,30 @@ SOURCES += main.cpp\
     blackout.cpp \
     tools.cpp \
     gameManager.cpp \
-    board.cpp
+    board.cpp \
+    neighbourhood.cpp \
+    solver.cpp \
+    textReader.cpp \
+    moveJournal.cpp \
+    puzzleBank.cpp \
+    instrumentation.cpp \
+    boardWidget.cpp \
+    largeSolver.cpp \
+    gameWorker.cpp
 
 HEADERS  += mainwindow.h \
     tools.h \
     gameManager.h \
     board.h \
-    blackout.h
+    neighbourhood.h \
+    blackout.h \
+    solver.h \
+    textReader.h \
+    moveJournal.h \
+    puzzleBank.h \
+    instrumentation.h \
+    boardWidget.h \
+    largeSolver.h \
+    gameWorker.h
 
 FORMS    += mainwindow.ui
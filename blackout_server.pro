@@ -0,0 +1,37 @@
+#-------------------------------------------------
+#
+# Puzzle and solution server on a Unix domain socket
+#
+#-------------------------------------------------
+
+QT       -= core gui
+
+TARGET = blackout_server
+TEMPLATE = app
+
+CONFIG   += console c++11 thread
+CONFIG   -= app_bundle qt
+
+
+SOURCES += serverMain.cpp \
+    server.cpp \
+    blackout.cpp \
+    solver.cpp \
+    largeSolver.cpp \
+    textReader.cpp \
+    moveJournal.cpp \
+    board.cpp \
+    neighbourhood.cpp \
+    tools.cpp \
+    instrumentation.cpp
+
+HEADERS  += server.h \
+    blackout.h \
+    solver.h \
+    largeSolver.h \
+    textReader.h \
+    moveJournal.h \
+    board.h \
+    neighbourhood.h \
+    tools.h \
+    instrumentation.h
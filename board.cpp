@@ -29,25 +29,133 @@
 #include "board.h"
 
 /**
- * Constructor for the board. Creates the board with the side given in sideLength.
+ * Constructor for the board. Creates the board with the side given in sideLength, which is limited to the range [1, MAX_LARGE_BOARDSIZE]. All cells are set to 0. The move mask of every cell is precomputed from the rule; a large board ignores the rule and follows the plus rule.
  * @param sideLength The side of the square. The default value is 3.
+ * @param rule The cells flipped by a move. The default value is the plus rule.
  */
-Board::Board (int sideLength)
+Board::Board (int sideLength, const Neighbourhood &rule)
 {
-  int i;
+  int i, j, index;
+
+  if (sideLength < 1)
+    {
+      sideLength = 1;
+    }
+  if (sideLength > MAX_LARGE_BOARDSIZE)
+    {
+      sideLength = MAX_LARGE_BOARDSIZE;
+    }
 
   this->boardSize = sideLength;
+  this->cell = 0;
+  this->initialState = 0;
+  this->rows = NULL;
+  this->initialRows = NULL;
+  this->rowWords = 0;
+  this->litCells = 0;
+  this->initialLitCells = 0;
+  this->firstColumnMask = 0;
+  this->lastColumnMask = 0;
+  this->neighbourhood = rule;
+
+  for (i=0; i<MAX_BOARDSIZE*MAX_BOARDSIZE; i++)
+    {
+      this->moveMask[i] = 0;
+      this->moveMaskSize[i] = 0;
+    }
+
+  if (sideLength > MAX_BOARDSIZE)
+    {
+      // A large board: each row is stored in words, and a move is applied to the words of three rows
+      this->boardMask = ~((uint64_t) 0);
+      this->neighbourhood = Neighbourhood (RULE_PLUS);
+      this->rowWords = (sideLength + 63) / 64;
+      this->rows = new uint64_t[this->getStateWords ()];
+      this->initialRows = new uint64_t[this->getStateWords ()];
+      memset (this->rows, 0, this->getStateWords () * sizeof (uint64_t));
+      memset (this->initialRows, 0, this->getStateWords () * sizeof (uint64_t));
+      return;
+    }
 
-  this->cell = new int* [sideLength];
-  this->initialState = new int* [sideLength];
+  if (sideLength*sideLength == 64)
+    {
+      this->boardMask = ~((uint64_t) 0);
+    }
+  else
+    {
+      this->boardMask = (((uint64_t) 1) << (sideLength*sideLength)) - 1;
+    }
 
+  // Precompute the mask flipped by a move at each cell, so that every rule costs one XOR per move
   for (i=0; i<sideLength; i++)
     {
-      this->cell[i] = new int[sideLength];
-      this->initialState[i] = new int[sideLength];
+      for (j=0; j<sideLength; j++)
+	{
+	  index = i*sideLength + j;
+	  if (j == 0)
+	    {
+	      this->firstColumnMask |= ((uint64_t) 1) << index;
+	    }
+	  if (j == sideLength-1)
+	    {
+	      this->lastColumnMask |= ((uint64_t) 1) << index;
+	    }
+	  this->moveMask[index] = this->neighbourhood.moveMask (sideLength, index);
+	  this->moveMaskSize[index] = popCount (this->moveMask[index]);
+	}
     }
 }
 
+/**
+ * Destructor that frees the rows of a large board.
+ */
+Board::~Board ()
+{
+  delete[] (this->rows);
+  this->rows = NULL;
+  delete[] (this->initialRows);
+  this->initialRows = NULL;
+}
+
+/**
+ * Flips the bits first to last, both included, of a row of a large board, and updates the count of lit cells. The run spans at most two words.
+ * @param row The first word of the row.
+ * @param first Index of the first bit flipped, from 0.
+ * @param last Index of the last bit flipped, from 0.
+ */
+void Board::flipRun (uint64_t *row, int first, int last)
+{
+  int word, lastWord = last >> 6;
+  uint64_t mask;
+
+  for (word = first >> 6; word <= lastWord; word++)
+    {
+      mask = ~((uint64_t) 0);
+      if (word == (first >> 6))
+	{
+	  mask &= mask << (first & 63);
+	}
+      if (word == lastWord)
+	{
+	  mask &= ~((uint64_t) 0) >> (63 - (last & 63));
+	}
+      // Every flipped cell that was lit goes out, every other one lights up
+      this->litCells += popCount (mask) - 2*popCount (row[word] & mask);
+      row[word] ^= mask;
+    }
+}
+
+/**
+ * Returns a pointer to the word holding the cell (x, y) of a large board, in the layout given by base.
+ * @param base The rows of the board, current or initial.
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ */
+uint64_t *Board::cellWord (uint64_t *base, int x, int y)
+{
+  return (base + (size_t) (x-1) * this->rowWords + (y-1) / 64);
+}
+
 /**
  * Sets the value in the cell pointed to by x and y to value. If the co-ordinates are valid, the return is true, else false.
  * @param x Row number of the cell.
@@ -58,7 +166,30 @@ bool Board::setCellValue (int x, int y, int value)
 {
   if (this->checkCoordinateSanity(x, y))
     {
-      this->cell[x-1][y-1] = value;
+      uint64_t *word = &(this->cell);
+      uint64_t bit;
+      if (this->rows)
+	{
+	  word = this->cellWord (this->rows, x, y);
+	  bit = ((uint64_t) 1) << ((y-1) & 63);
+	}
+      else
+	{
+	  bit = ((uint64_t) 1) << ((x-1)*this->boardSize + (y-1));
+	}
+      if ((*word & bit) != 0)
+	{
+	  (this->litCells)--;
+	}
+      if (value)
+	{
+	  *word |= bit;
+	  (this->litCells)++;
+	}
+      else
+	{
+	  *word &= ~bit;
+	}
       return (true);
     }
   else
@@ -77,7 +208,14 @@ bool Board::getCellValue (int x, int y, int *value)
 {
   if (this->checkCoordinateSanity(x, y))
     {
-      *value = this->cell[x-1][y-1];
+      if (this->rows)
+	{
+	  *value = (int) ((*(this->cellWord (this->rows, x, y)) >> ((y-1) & 63)) & 1);
+	}
+      else
+	{
+	  *value = (int) ((this->cell >> ((x-1)*this->boardSize + (y-1))) & 1);
+	}
       return (true);
     }
   else
@@ -96,7 +234,30 @@ bool Board::setInitialCellValue (int x, int y, int value)
 {
   if (this->checkCoordinateSanity(x, y))
     {
-      this->initialState[x-1][y-1] = value;
+      uint64_t *word = &(this->initialState);
+      uint64_t bit;
+      if (this->initialRows)
+	{
+	  word = this->cellWord (this->initialRows, x, y);
+	  bit = ((uint64_t) 1) << ((y-1) & 63);
+	}
+      else
+	{
+	  bit = ((uint64_t) 1) << ((x-1)*this->boardSize + (y-1));
+	}
+      if ((*word & bit) != 0)
+	{
+	  (this->initialLitCells)--;
+	}
+      if (value)
+	{
+	  *word |= bit;
+	  (this->initialLitCells)++;
+	}
+      else
+	{
+	  *word &= ~bit;
+	}
       return (true);
     }
   else
@@ -115,7 +276,81 @@ bool Board::getInitialCellValue (int x, int y, int *value)
 {
   if (this->checkCoordinateSanity(x, y))
     {
-      *value = this->initialState[x-1][y-1];
+      if (this->initialRows)
+	{
+	  *value = (int) ((*(this->cellWord (this->initialRows, x, y)) >> ((y-1) & 63)) & 1);
+	}
+      else
+	{
+	  *value = (int) ((this->initialState >> ((x-1)*this->boardSize + (y-1))) & 1);
+	}
+      return (true);
+    }
+  else
+    {
+      return (false);
+    }
+}
+
+/**
+ * Flips the value of the cell at (x, y). If the co-ordinates are valid, the return is true, else false.
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ */
+bool Board::flipCell (int x, int y)
+{
+  if (this->checkCoordinateSanity(x, y))
+    {
+      uint64_t *word = &(this->cell);
+      uint64_t bit;
+      if (this->rows)
+	{
+	  word = this->cellWord (this->rows, x, y);
+	  bit = ((uint64_t) 1) << ((y-1) & 63);
+	}
+      else
+	{
+	  bit = ((uint64_t) 1) << ((x-1)*this->boardSize + (y-1));
+	}
+      // The cell goes from lit to unlit or the other way round
+      this->litCells += ((*word & bit) != 0) ? -1 : 1;
+      *word ^= bit;
+      return (true);
+    }
+  else
+    {
+      return (false);
+    }
+}
+
+/**
+ * Flips the cells of the neighbourhood of (x, y), under the plus rule the cell together with its neighbours above, below, to the left and to the right. Whatever the rule this is a single XOR of the precomputed move mask, or on a large board one masked XOR per affected word. If the co-ordinates are valid, the return is true, else false.
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ */
+bool Board::pressCell (int x, int y)
+{
+  if (this->checkCoordinateSanity(x, y))
+    {
+      if (this->rows)
+	{
+	  uint64_t *row = this->rows + (size_t) (x-1) * this->rowWords;
+	  // The run of the cell and its left and right neighbours is clipped at the edges of the row
+	  this->flipRun (row, (y > 1) ? y-2 : 0, (y < this->boardSize) ? y : y-1);
+	  if (x > 1)
+	    {
+	      this->flipRun (row - this->rowWords, y-1, y-1);
+	    }
+	  if (x < this->boardSize)
+	    {
+	      this->flipRun (row + this->rowWords, y-1, y-1);
+	    }
+	  return (true);
+	}
+      int index = (x-1)*this->boardSize + (y-1);
+      // Every flipped cell that was lit goes out, every other one lights up
+      this->litCells += this->moveMaskSize[index] - 2*popCount (this->cell & this->moveMask[index]);
+      this->cell ^= this->moveMask[index];
       return (true);
     }
   else
@@ -124,6 +359,288 @@ bool Board::getInitialCellValue (int x, int y, int *value)
     }
 }
 
+/**
+ * Presses every cell whose bit is set in presses, as pressCell does for a single cell. The bit i is the cell of index i = (x-1)*boardSize + (y-1), so on a large board only the first 64 cells can be pressed.
+ * @param presses The set of cells to press, one bit per cell.
+ */
+void Board::pressCells (uint64_t presses)
+{
+  int index;
+
+  presses &= this->boardMask;
+  if (this->rows)
+    {
+      while (presses)
+	{
+	  index = popCount ((presses & (~presses + 1)) - 1);
+	  this->pressCell (index / this->boardSize + 1, index % this->boardSize + 1);
+	  presses &= presses - 1;
+	}
+      return;
+    }
+  this->applyPressPattern (&presses);
+}
+
+/**
+ * Presses every cell set in a press pattern. As presses commute and a press twice cancels out, under the plus rule the board is XORed with the pattern and with the pattern shifted by one cell up, down, left and right; the shifts are word shifts, masked at the edges of the rows and of the board, in one pass over the words of the board whatever the number of presses. Under any other rule the move masks of the pressed cells are XORed in turn.
+ * @param presses The press pattern, in the layout of snapshot: getStateWords() words, with the bits past the end of every row set to 0.
+ */
+void Board::applyPressPattern (const uint64_t *presses)
+{
+  uint64_t p, flip, lastWordMask;
+  uint64_t *target;
+  const uint64_t *row;
+  int x, w, n = this->boardSize, words = this->rowWords;
+
+  if (!this->rows)
+    {
+      p = presses[0] & this->boardMask;
+      if (!this->neighbourhood.isPlus ())
+	{
+	  // Each set bit costs one XOR of its precomputed move mask
+	  for (flip=0; p; p&=p-1)
+	    {
+	      flip ^= this->moveMask[popCount ((p & (~p + 1)) - 1)];
+	    }
+	  this->cell ^= flip;
+	  this->litCells = popCount (this->cell);
+	  return;
+	}
+      // The cell above is boardSize bits lower, the cell to the left one bit lower
+      flip = p ^ (p << n) ^ (p >> n) ^ ((p << 1) & ~this->firstColumnMask) ^ ((p >> 1) & ~this->lastColumnMask);
+      this->cell ^= flip & this->boardMask;
+      this->litCells = popCount (this->cell);
+      return;
+    }
+
+  lastWordMask = (n % 64) ? (((uint64_t) 1) << (n % 64)) - 1 : ~((uint64_t) 0);
+  for (x=0; x<n; x++)
+    {
+      row = presses + (size_t) x * words;
+      target = this->rows + (size_t) x * words;
+      for (w=0; w<words; w++)
+	{
+	  // The press itself, and the presses to the left and to the right carried across words
+	  flip = row[w] ^ (row[w] << 1) ^ (row[w] >> 1);
+	  if (w > 0)
+	    {
+	      flip ^= row[w-1] >> 63;
+	    }
+	  if (w < words-1)
+	    {
+	      flip ^= row[w+1] << 63;
+	    }
+	  // The presses in the rows above and below
+	  if (x > 0)
+	    {
+	      flip ^= row[w - words];
+	    }
+	  if (x < n-1)
+	    {
+	      flip ^= row[w + words];
+	    }
+	  if (w == words-1)
+	    {
+	      flip &= lastWordMask;
+	    }
+	  this->litCells += popCount (flip) - 2*popCount (target[w] & flip);
+	  target[w] ^= flip;
+	}
+    }
+}
+
+/**
+ * Returns the number of cells flipped by a move at (x, y): the cells of its neighbourhood inside the board.
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ */
+int Board::getMoveSize (int x, int y)
+{
+  if (!this->rows && this->checkCoordinateSanity (x, y))
+    {
+      return (this->moveMaskSize[(x-1)*this->boardSize + (y-1)]);
+    }
+  return (1 + (x > 1) + (x < this->boardSize) + (y > 1) + (y < this->boardSize));
+}
+
+/**
+ * Returns the current state of the board, one bit per cell. On a large board, the first 64 cells in the order of their index (x-1)*boardSize + (y-1).
+ */
+uint64_t Board::getState ()
+{
+  uint64_t state = 0;
+  int i, value = 0;
+
+  if (!this->rows)
+    {
+      return (this->cell);
+    }
+  for (i=0; i<64; i++)
+    {
+      this->getCellValue (i / this->boardSize + 1, i % this->boardSize + 1, &value);
+      state |= ((uint64_t) value) << i;
+    }
+  return (state);
+}
+
+/**
+ * Sets the current state of the board, one bit per cell. Bits outside the board are ignored. On a large board, the first 64 cells in the order of their index are set from state and all the other cells are set to 0.
+ * @param state The new state of the board.
+ */
+void Board::setState (uint64_t state)
+{
+  int i;
+
+  if (!this->rows)
+    {
+      this->cell = state & this->boardMask;
+      this->litCells = popCount (this->cell);
+      return;
+    }
+  memset (this->rows, 0, this->getStateWords () * sizeof (uint64_t));
+  this->litCells = 0;
+  for (i=0; i<64; i++)
+    {
+      if ((state >> i) & 1)
+	{
+	  this->flipCell (i / this->boardSize + 1, i % this->boardSize + 1);
+	}
+    }
+}
+
+/**
+ * Returns the initial state of the board, one bit per cell. On a large board, the first 64 cells in the order of their index.
+ */
+uint64_t Board::getInitialState ()
+{
+  uint64_t state = 0;
+  int i, value = 0;
+
+  if (!this->initialRows)
+    {
+      return (this->initialState);
+    }
+  for (i=0; i<64; i++)
+    {
+      this->getInitialCellValue (i / this->boardSize + 1, i % this->boardSize + 1, &value);
+      state |= ((uint64_t) value) << i;
+    }
+  return (state);
+}
+
+/**
+ * Returns the move mask of the cell with the given bit index, that is, the cells flipped by a move at that cell. The move masks are only kept for boards packed in one word; the return value is 0 on a large board.
+ * @param index Bit index (x-1)*boardSize + (y-1) of the cell.
+ */
+uint64_t Board::getMoveMask (int index)
+{
+  if (this->rows)
+    {
+      return (0);
+    }
+  return (this->moveMask[index]);
+}
+
+/**
+ * Returns whether the board is large, that is whether its side is above MAX_BOARDSIZE and its rows are stored in words.
+ */
+bool Board::isLarge ()
+{
+  return (this->rows != NULL);
+}
+
+/**
+ * Returns the number of 64-bit words taken by a snapshot of the board: 1 for a board packed in one word, boardSize times the words of a row for a large board.
+ */
+size_t Board::getStateWords ()
+{
+  if (this->rowWords == 0)
+    {
+      return (1);
+    }
+  return ((size_t) this->boardSize * this->rowWords);
+}
+
+/**
+ * Copies the current state of the board to destination, which holds getStateWords() words.
+ * @param destination The location where the state is copied.
+ */
+void Board::snapshot (uint64_t *destination)
+{
+  if (this->rows)
+    {
+      memcpy (destination, this->rows, this->getStateWords () * sizeof (uint64_t));
+    }
+  else
+    {
+      destination[0] = this->cell;
+    }
+}
+
+/**
+ * Sets the current state of the board from a snapshot taken by snapshot. Bits outside the board are ignored.
+ * @param source The snapshot, of getStateWords() words.
+ */
+void Board::restore (const uint64_t *source)
+{
+  int i;
+  uint64_t lastWordMask;
+
+  if (!this->rows)
+    {
+      this->setState (source[0]);
+      return;
+    }
+  memcpy (this->rows, source, this->getStateWords () * sizeof (uint64_t));
+  // Clear the bits past the end of every row
+  if (this->boardSize % 64)
+    {
+      lastWordMask = (((uint64_t) 1) << (this->boardSize % 64)) - 1;
+      for (i=1; i<=this->boardSize; i++)
+	{
+	  this->rows[(size_t) i * this->rowWords - 1] &= lastWordMask;
+	}
+    }
+  this->litCells = (int64_t) popCountWords (this->rows, this->getStateWords ());
+}
+
+/**
+ * Returns the number of cells that differ between the current state of the board and a snapshot taken by snapshot.
+ * @param source The snapshot, of getStateWords() words.
+ */
+int64_t Board::countDifferences (const uint64_t *source)
+{
+  if (!this->rows)
+    {
+      return (popCount ((this->cell ^ source[0]) & this->boardMask));
+    }
+  return ((int64_t) xorPopCountWords (this->rows, source, this->getStateWords ()));
+}
+
+/**
+ * Returns the mask with one bit set for every cell of the board.
+ */
+uint64_t Board::getBoardMask ()
+{
+  return (this->boardMask);
+}
+
+/**
+ * Returns the length of the side of the board.
+ */
+int Board::getSize ()
+{
+  return (this->boardSize);
+}
+
+/**
+ * Returns the rule of the moves of the board.
+ */
+const Neighbourhood &Board::getNeighbourhood ()
+{
+  return (this->neighbourhood);
+}
+
 /**
  * Checks the sanity of the coordinates entered. If 0 or negative values, as well as those exceeding the board dimensions are entered, the function returns false, else the return value is true.
  * @param x Row number of the cell.
@@ -160,15 +677,12 @@ bool Board::checkCoordinateSanity (int x, int y)
  */
 void Board::setInitialState ()
 {
-  int i, j;
-
-  for (i=0; i<this->boardSize; i++)
+  if (this->rows)
     {
-      for (j=0; j<this->boardSize; j++)
-	{
-	  this->initialState[i][j] = this->cell[i][j];
-	}
+      memcpy (this->initialRows, this->rows, this->getStateWords () * sizeof (uint64_t));
     }
+  this->initialState = this->cell;
+  this->initialLitCells = this->litCells;
 }
 
 /**
@@ -176,32 +690,18 @@ void Board::setInitialState ()
  */
 void Board::resetBoard()
 {
-  int i, j;
-
-  for (i=0; i<this->boardSize; i++)
+  if (this->rows)
     {
-      for (j=0; j<this->boardSize; j++)
-	{
-	  this->cell[i][j] = this->initialState[i][j];
-	}
+      memcpy (this->rows, this->initialRows, this->getStateWords () * sizeof (uint64_t));
     }
+  this->cell = this->initialState;
+  this->litCells = this->initialLitCells;
 }
 
 /**
- * Returns the sum of the elements on the board.
+ * Returns the sum of the elements on the board, that is the number of cells of value 1. The count is kept up to date as cells change, so no cell is read.
  */
-int Board::sum ()
+int64_t Board::sum ()
 {
-  int s=0;
-  int i, j;
-
-  for (i=0; i<boardSize; i++)
-    {
-      for (j=0; j<boardSize; j++)
-	{
-	  s += this->cell[i][j];
-	}
-    }
-
-  return (s);
+  return (this->litCells);
 }
@@ -29,37 +29,128 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include <stdint.h>
+#include <string.h>
+
 #include "tools.h"
+#include "neighbourhood.h"
 
 #ifndef DEFAULT_BOARDSIZE
 #define DEFAULT_BOARDSIZE 3
 #endif
 
+/**
+ * The largest side length for which the whole board fits in one 64-bit word.
+ */
+#ifndef MAX_BOARDSIZE
+#define MAX_BOARDSIZE 8
+#endif
+
+/**
+ * The largest side length of a board. Boards larger than MAX_BOARDSIZE store each row in 64-bit words.
+ */
+#ifndef MAX_LARGE_BOARDSIZE
+#define MAX_LARGE_BOARDSIZE 65536
+#endif
+
 /**
  * The Board class to represent the playing board.
+ * A board of side up to MAX_BOARDSIZE is packed in a single 64-bit word. A larger board, of side up to MAX_LARGE_BOARDSIZE, stores each row in consecutive 64-bit words: a move flips a run of at most three bits in its row and one bit in each of the rows above and below, and whole-board operations (snapshot, reset, comparison, counting) run over the words. Both layouts have the same moves, including at the edges.
  */
 class Board
 {
  private:
   /**
-   * Representing the two dimensional square board with cells of values 0 or 1.
+   * Representing the two dimensional square board with cells of values 0 or 1. The cell (x, y) is stored in the bit (x-1)*boardSize + (y-1). Not used by a large board.
+   */
+  uint64_t cell;
+  /**
+   * Stores the initial state of the cell in case a reset is required. Not used by a large board.
    */
-  int **cell;
+  uint64_t initialState;
   /**
-   * Stores the initial state of the cell in case a reset is required.
+   * The cells of a large board, or NULL for a board packed in one word. The row x is stored in the rowWords words from rows + (x-1)*rowWords, the cell (x, y) in the bit (y-1)%64 of the word (y-1)/64 of its row. The bits past the end of a row are always 0.
    */
-  int **initialState;
+  uint64_t *rows;
+  /**
+   * The initial state of a large board, in the layout of rows, or NULL for a board packed in one word.
+   */
+  uint64_t *initialRows;
+  /**
+   * Number of 64-bit words in a row of a large board, 0 for a board packed in one word.
+   */
+  int rowWords;
   /**
    * The length of the side of the square board.
    */
   int boardSize;
+  /**
+   * Mask with one bit set for every cell of the board. All 64 bits are set for a large board.
+   */
+  uint64_t boardMask;
+  /**
+   * Mask of the cells of the first column, 0 for a large board.
+   */
+  uint64_t firstColumnMask;
+  /**
+   * Mask of the cells of the last column, 0 for a large board.
+   */
+  uint64_t lastColumnMask;
+  /**
+   * For every cell, the mask of the cells flipped by a move at that cell, precomputed from the neighbourhood: under the plus rule, the cell itself and its neighbours above, below, to the left and to the right.
+   */
+  uint64_t moveMask[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  /**
+   * Number of cells flipped by a move at each cell, the number of bits of its move mask.
+   */
+  int moveMaskSize[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  /**
+   * The rule of the moves. A large board always follows the plus rule.
+   */
+  Neighbourhood neighbourhood;
+  /**
+   * Number of cells of value 1 on the board, kept up to date by every change to the board.
+   */
+  int64_t litCells;
+  /**
+   * Number of cells of value 1 in the initial state.
+   */
+  int64_t initialLitCells;
+
+  /**
+   * Flips the bits first to last, both included, of a row of a large board, and updates the count of lit cells. The run spans at most two words.
+   * @param row The first word of the row.
+   * @param first Index of the first bit flipped, from 0.
+   * @param last Index of the last bit flipped, from 0.
+   */
+  void flipRun (uint64_t *row, int first, int last);
+  /**
+   * Returns a pointer to the word holding the cell (x, y) of a large board, in the layout given by base.
+   * @param base The rows of the board, current or initial.
+   * @param x Row number of the cell.
+   * @param y Column number of the cell.
+   */
+  uint64_t *cellWord (uint64_t *base, int x, int y);
+  /**
+   * Boards are not copied: a copy would share the rows of a large board.
+   */
+  Board (const Board &board);
+  /**
+   * Boards are not assigned: an assignment would share the rows of a large board.
+   */
+  Board &operator= (const Board &board);
 
  public:
   /**
-   * Constructor for the board. Creates the board with the side given in sideLength.
+   * Constructor for the board. Creates the board with the side given in sideLength, which is limited to the range [1, MAX_LARGE_BOARDSIZE]. All cells are set to 0. The move mask of every cell is precomputed from the rule; a large board ignores the rule and follows the plus rule.
    * @param sideLength The side of the square. The default value is 3.
+   * @param rule The cells flipped by a move. The default value is the plus rule.
    */
-  Board (int sideLength=DEFAULT_BOARDSIZE);
+  Board (int sideLength=DEFAULT_BOARDSIZE, const Neighbourhood &rule=Neighbourhood ());
+  /**
+   * Destructor that frees the rows of a large board.
+   */
+  ~Board ();
   /**
    * Sets the value in the cell pointed to by x and y to value. If the co-ordinates are valid, the return is true, else false.
    * @param x Row number of the cell.
@@ -88,6 +179,87 @@ class Board
    * @param value Pointer to the location in memory where the value of the cell is copied.
    */
   bool getInitialCellValue (int x, int y, int *value);
+  /**
+   * Flips the value of the cell at (x, y). If the co-ordinates are valid, the return is true, else false.
+   * @param x Row number of the cell.
+   * @param y Column number of the cell.
+   */
+  bool flipCell (int x, int y);
+  /**
+   * Flips the cells of the neighbourhood of (x, y), under the plus rule the cell together with its neighbours above, below, to the left and to the right. Whatever the rule this is a single XOR of the precomputed move mask, or on a large board one masked XOR per affected word. If the co-ordinates are valid, the return is true, else false.
+   * @param x Row number of the cell.
+   * @param y Column number of the cell.
+   */
+  bool pressCell (int x, int y);
+  /**
+   * Presses every cell whose bit is set in presses, as pressCell does for a single cell. The bit i is the cell of index i = (x-1)*boardSize + (y-1), so on a large board only the first 64 cells can be pressed.
+   * @param presses The set of cells to press, one bit per cell.
+   */
+  void pressCells (uint64_t presses);
+  /**
+   * Presses every cell set in a press pattern. As presses commute and a press twice cancels out, under the plus rule the board is XORed with the pattern and with the pattern shifted by one cell up, down, left and right; the shifts are word shifts, masked at the edges of the rows and of the board, in one pass over the words of the board whatever the number of presses. Under any other rule the move masks of the pressed cells are XORed in turn.
+   * @param presses The press pattern, in the layout of snapshot: getStateWords() words, with the bits past the end of every row set to 0.
+   */
+  void applyPressPattern (const uint64_t *presses);
+  /**
+   * Returns the number of cells flipped by a move at (x, y): the cells of its neighbourhood inside the board.
+   * @param x Row number of the cell.
+   * @param y Column number of the cell.
+   */
+  int getMoveSize (int x, int y);
+  /**
+   * Returns the current state of the board, one bit per cell. On a large board, the first 64 cells in the order of their index (x-1)*boardSize + (y-1).
+   */
+  uint64_t getState ();
+  /**
+   * Sets the current state of the board, one bit per cell. Bits outside the board are ignored. On a large board, the first 64 cells in the order of their index are set from state and all the other cells are set to 0.
+   * @param state The new state of the board.
+   */
+  void setState (uint64_t state);
+  /**
+   * Returns the initial state of the board, one bit per cell. On a large board, the first 64 cells in the order of their index.
+   */
+  uint64_t getInitialState ();
+  /**
+   * Returns the move mask of the cell with the given bit index, that is, the cells flipped by a move at that cell. The move masks are only kept for boards packed in one word; the return value is 0 on a large board.
+   * @param index Bit index (x-1)*boardSize + (y-1) of the cell.
+   */
+  uint64_t getMoveMask (int index);
+  /**
+   * Returns whether the board is large, that is whether its side is above MAX_BOARDSIZE and its rows are stored in words.
+   */
+  bool isLarge ();
+  /**
+   * Returns the number of 64-bit words taken by a snapshot of the board: 1 for a board packed in one word, boardSize times the words of a row for a large board.
+   */
+  size_t getStateWords ();
+  /**
+   * Copies the current state of the board to destination, which holds getStateWords() words.
+   * @param destination The location where the state is copied.
+   */
+  void snapshot (uint64_t *destination);
+  /**
+   * Sets the current state of the board from a snapshot taken by snapshot. Bits outside the board are ignored.
+   * @param source The snapshot, of getStateWords() words.
+   */
+  void restore (const uint64_t *source);
+  /**
+   * Returns the number of cells that differ between the current state of the board and a snapshot taken by snapshot.
+   * @param source The snapshot, of getStateWords() words.
+   */
+  int64_t countDifferences (const uint64_t *source);
+  /**
+   * Returns the mask with one bit set for every cell of the board.
+   */
+  uint64_t getBoardMask ();
+  /**
+   * Returns the length of the side of the board.
+   */
+  int getSize ();
+  /**
+   * Returns the rule of the moves of the board.
+   */
+  const Neighbourhood &getNeighbourhood ();
   /**
    * Resets the board to it's initial value.
    */
@@ -103,9 +275,9 @@ class Board
    */
   bool checkCoordinateSanity (int x, int y);
   /**
-   * Returns the sum of the elements on the board.
+   * Returns the sum of the elements on the board, that is the number of cells of value 1. The count is kept up to date as cells change, so no cell is read.
    */
-  int sum ();
+  int64_t sum ();
 };
 
 #endif
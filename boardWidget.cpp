@@ -0,0 +1,570 @@
+/**
+ *@file boardWidget.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with implementation of the class BoardWidget.
+ *@details The BoardWidget class shows the board of a game of blackout and lets the player press cells, zoom and pan.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "boardWidget.h"
+
+#include <cmath>
+#include <vector>
+
+#include <QApplication>
+#include <QImage>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QPen>
+#include <QWheelEvent>
+
+/**
+ * Colour of a cell of value 1.
+ */
+static const QRgb litColour = qRgb (240, 200, 40);
+/**
+ * Colour of a cell of value 0.
+ */
+static const QRgb unlitColour = qRgb (48, 48, 56);
+/**
+ * Colour of the widget around the board.
+ */
+static const QRgb backgroundColour = qRgb (20, 20, 24);
+
+/**
+ * Constructor that creates a widget with no game.
+ * @param parent The parent widget.
+ */
+BoardWidget::BoardWidget (QWidget *parent) : QWidget (parent)
+{
+  this->game = NULL;
+  this->cellSize = 32;
+  this->origin = QPointF (0, 0);
+  this->dragging = false;
+  this->hintX = 0;
+  this->hintY = 0;
+
+  this->setAttribute (Qt::WA_OpaquePaintEvent);
+  this->setFocusPolicy (Qt::StrongFocus);
+  this->setMinimumSize (64, 64);
+  this->makePixmaps ();
+}
+
+/**
+ * Shows a game. The widget does not take ownership of the game.
+ * @param newGame The game, or NULL.
+ */
+void BoardWidget::setGame (Blackout *newGame)
+{
+  this->game = newGame;
+  this->hintX = 0;
+  this->hintY = 0;
+  this->fitBoard ();
+}
+
+/**
+ * Redraws the cached pixmaps of the cells at the current cell size.
+ */
+void BoardWidget::makePixmaps ()
+{
+  int size = (int) this->cellSize;
+
+  if (size < BOARDWIDGET_PIXMAP_SIZE)
+    {
+      return;
+    }
+  if (!this->litPixmap.isNull () && this->litPixmap.width () == size)
+    {
+      return;
+    }
+
+  this->litPixmap = QPixmap (size, size);
+  this->unlitPixmap = QPixmap (size, size);
+  this->litPixmap.fill (QColor (backgroundColour));
+  this->unlitPixmap.fill (QColor (backgroundColour));
+
+  // Leave a one pixel gap between cells, and round the corners of the larger ones.
+  int radius = size/8;
+  QRectF face (0.5, 0.5, size-1, size-1);
+
+  QPainter litPainter (&this->litPixmap);
+  litPainter.setRenderHint (QPainter::Antialiasing);
+  litPainter.setPen (Qt::NoPen);
+  litPainter.setBrush (QColor (litColour));
+  litPainter.drawRoundedRect (face, radius, radius);
+
+  QPainter unlitPainter (&this->unlitPixmap);
+  unlitPainter.setRenderHint (QPainter::Antialiasing);
+  unlitPainter.setPen (Qt::NoPen);
+  unlitPainter.setBrush (QColor (unlitColour));
+  unlitPainter.drawRoundedRect (face, radius, radius);
+}
+
+/**
+ * Returns the rectangle of the widget covered by the cell (x, y).
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ */
+QRect BoardWidget::cellRect (int x, int y)
+{
+  int left = (int) std::floor (this->origin.x () + (y-1)*this->cellSize);
+  int top = (int) std::floor (this->origin.y () + (x-1)*this->cellSize);
+  int right = (int) std::floor (this->origin.x () + y*this->cellSize);
+  int bottom = (int) std::floor (this->origin.y () + x*this->cellSize);
+
+  // A cell smaller than a pixel still covers the pixel it is sampled in.
+  if (right == left)
+    {
+      right++;
+    }
+  if (bottom == top)
+    {
+      bottom++;
+    }
+  return (QRect (left, top, right-left, bottom-top));
+}
+
+/**
+ * Returns the rectangle of the widget covered by the mark of the hint, which is at least a few pixels wide even when the cells are smaller.
+ */
+QRect BoardWidget::hintRect ()
+{
+  QRect cell = this->cellRect (this->hintX, this->hintY);
+
+  if (cell.width () >= BOARDWIDGET_PIXMAP_SIZE)
+    {
+      return (cell);
+    }
+  return (QRect (cell.center () - QPoint (BOARDWIDGET_PIXMAP_SIZE, BOARDWIDGET_PIXMAP_SIZE), QSize (2*BOARDWIDGET_PIXMAP_SIZE, 2*BOARDWIDGET_PIXMAP_SIZE)));
+}
+
+/**
+ * Finds the cell under a point of the widget. The return value is false if the point is outside the board.
+ * @param point The point.
+ * @param x Pointer to the location where the row number of the cell is copied.
+ * @param y Pointer to the location where the column number of the cell is copied.
+ */
+bool BoardWidget::cellAt (const QPoint &point, int *x, int *y)
+{
+  if (!this->game)
+    {
+      return (false);
+    }
+
+  double row = std::floor ((point.y () + 0.5 - this->origin.y ())/this->cellSize);
+  double column = std::floor ((point.x () + 0.5 - this->origin.x ())/this->cellSize);
+  int size = this->game->getSize ();
+
+  if (row < 0 || row >= size || column < 0 || column >= size)
+    {
+      return (false);
+    }
+  *x = (int) row + 1;
+  *y = (int) column + 1;
+  return (true);
+}
+
+/**
+ * Sets the width of a cell, keeping the point of the board under the given point of the widget in place.
+ * @param size The new width of a cell, limited to the range [BOARDWIDGET_MIN_CELL_SIZE, BOARDWIDGET_MAX_CELL_SIZE].
+ * @param center The point of the widget which stays in place.
+ */
+void BoardWidget::zoomTo (double size, const QPointF &center)
+{
+  if (size < BOARDWIDGET_MIN_CELL_SIZE)
+    {
+      size = BOARDWIDGET_MIN_CELL_SIZE;
+    }
+  if (size > BOARDWIDGET_MAX_CELL_SIZE)
+    {
+      size = BOARDWIDGET_MAX_CELL_SIZE;
+    }
+  // Pixmaps are only drawn at whole sizes, so that they are never scaled.
+  if (size >= BOARDWIDGET_PIXMAP_SIZE)
+    {
+      size = std::floor (size + 0.5);
+    }
+
+  this->origin = center - (center - this->origin)*(size/this->cellSize);
+  this->cellSize = size;
+  this->makePixmaps ();
+  this->update ();
+}
+
+/**
+ * Draws the cells that meet a rectangle of the widget from the cached pixmaps.
+ * @param painter The painter of the widget.
+ * @param rect The rectangle.
+ */
+void BoardWidget::paintPixmaps (QPainter *painter, const QRect &rect)
+{
+  int size = this->game->getSize ();
+  int firstRow, lastRow, firstColumn, lastColumn;
+  int x, y, value;
+
+  firstRow = (int) std::floor ((rect.top () - this->origin.y ())/this->cellSize) + 1;
+  lastRow = (int) std::floor ((rect.bottom () - this->origin.y ())/this->cellSize) + 1;
+  firstColumn = (int) std::floor ((rect.left () - this->origin.x ())/this->cellSize) + 1;
+  lastColumn = (int) std::floor ((rect.right () - this->origin.x ())/this->cellSize) + 1;
+
+  if (firstRow < 1)
+    {
+      firstRow = 1;
+    }
+  if (firstColumn < 1)
+    {
+      firstColumn = 1;
+    }
+  if (lastRow > size)
+    {
+      lastRow = size;
+    }
+  if (lastColumn > size)
+    {
+      lastColumn = size;
+    }
+
+  for (x=firstRow; x<=lastRow; x++)
+    {
+      for (y=firstColumn; y<=lastColumn; y++)
+	{
+	  this->game->getCellValue (x, y, &value);
+	  painter->drawPixmap (this->cellRect (x, y).topLeft (), value ? this->litPixmap : this->unlitPixmap);
+	}
+    }
+}
+
+/**
+ * Draws a rectangle of the widget pixel by pixel, each pixel showing the cell under its center.
+ * @param painter The painter of the widget.
+ * @param rect The rectangle.
+ */
+void BoardWidget::paintPixels (QPainter *painter, const QRect &rect)
+{
+  int size = this->game->getSize ();
+  int width = rect.width ();
+  int height = rect.height ();
+  int i, j, x, value;
+  QImage image (width, height, QImage::Format_RGB32);
+  std::vector<int> columns (width);
+
+  // The column under each pixel is the same on every line of the image.
+  for (j=0; j<width; j++)
+    {
+      double column = std::floor ((rect.left () + j + 0.5 - this->origin.x ())/this->cellSize);
+      columns[j] = (column < 0 || column >= size) ? 0 : (int) column + 1;
+    }
+
+  for (i=0; i<height; i++)
+    {
+      QRgb *line = (QRgb *) image.scanLine (i);
+      double row = std::floor ((rect.top () + i + 0.5 - this->origin.y ())/this->cellSize);
+
+      x = (row < 0 || row >= size) ? 0 : (int) row + 1;
+      for (j=0; j<width; j++)
+	{
+	  if (x == 0 || columns[j] == 0)
+	    {
+	      line[j] = backgroundColour;
+	    }
+	  else
+	    {
+	      this->game->getCellValue (x, columns[j], &value);
+	      line[j] = value ? litColour : unlitColour;
+	    }
+	}
+    }
+
+  painter->drawImage (rect.topLeft (), image);
+}
+
+/**
+ * Repaints the rectangles of the widget that need it.
+ * @param event The paint event, with the region to repaint.
+ */
+void BoardWidget::paintEvent (QPaintEvent *event)
+{
+  QPainter painter (this);
+  QRect rect = event->rect ();
+
+  if (!this->game)
+    {
+      painter.fillRect (rect, QColor (backgroundColour));
+      return;
+    }
+
+  ScopedTimer timer (OP_PAINT);
+
+  if (this->cellSize >= BOARDWIDGET_PIXMAP_SIZE)
+    {
+      painter.fillRect (rect, QColor (backgroundColour));
+      this->paintPixmaps (&painter, rect);
+    }
+  else
+    {
+      this->paintPixels (&painter, rect);
+    }
+
+  if (this->hintX > 0 && this->hintRect ().intersects (rect))
+    {
+      painter.setPen (QPen (QColor (220, 40, 40), 2));
+      painter.setBrush (Qt::NoBrush);
+      painter.drawRect (this->hintRect ().adjusted (1, 1, -1, -1));
+    }
+}
+
+/**
+ * Starts a click or a drag.
+ * @param event The mouse event.
+ */
+void BoardWidget::mousePressEvent (QMouseEvent *event)
+{
+  this->pressPosition = event->pos ();
+  this->dragging = (event->button () != Qt::LeftButton);
+}
+
+/**
+ * Pans the board while it is dragged.
+ * @param event The mouse event.
+ */
+void BoardWidget::mouseMoveEvent (QMouseEvent *event)
+{
+  if (event->buttons () == Qt::NoButton)
+    {
+      return;
+    }
+
+  QPoint offset = event->pos () - this->pressPosition;
+
+  // A left button press only becomes a drag once the mouse has moved far enough to rule out a click.
+  if (!this->dragging && offset.manhattanLength () < QApplication::startDragDistance ())
+    {
+      return;
+    }
+
+  this->dragging = true;
+  this->origin += offset;
+  this->pressPosition = event->pos ();
+  this->scroll (offset.x (), offset.y ());
+}
+
+/**
+ * Carries out the move at the cell clicked, unless the board was dragged.
+ * @param event The mouse event.
+ */
+void BoardWidget::mouseReleaseEvent (QMouseEvent *event)
+{
+  int x, y;
+
+  if (this->dragging || event->button () != Qt::LeftButton)
+    {
+      this->dragging = false;
+      return;
+    }
+
+  if (!this->cellAt (event->pos (), &x, &y) || !this->game->applyMove (x, y))
+    {
+      return;
+    }
+
+  this->refreshMove (x, y);
+  emit this->moved (x, y);
+  if (this->game->checkWinCondition ())
+    {
+      emit this->won ();
+    }
+}
+
+/**
+ * Zooms around the cursor.
+ * @param event The wheel event.
+ */
+void BoardWidget::wheelEvent (QWheelEvent *event)
+{
+#if QT_VERSION >= 0x050000
+  int delta = event->angleDelta ().y ();
+#else
+  int delta = event->delta ();
+#endif
+
+  if (delta == 0)
+    {
+      event->ignore ();
+      return;
+    }
+
+  // One notch of the wheel is 120 units.
+  double size = this->cellSize*std::pow (BOARDWIDGET_ZOOM_STEP, delta/120.0);
+
+  // Whole cell sizes change by at least one pixel per notch, or small steps would round back to the same size.
+  if (size >= BOARDWIDGET_PIXMAP_SIZE && std::floor (size + 0.5) == this->cellSize)
+    {
+      size = this->cellSize + (delta > 0 ? 1 : -1);
+    }
+
+  this->zoomTo (size, event->pos ());
+  event->accept ();
+}
+
+/**
+ * Zooms with + and -, pans with the arrow keys and fits the board with 0.
+ * @param event The key event.
+ */
+void BoardWidget::keyPressEvent (QKeyEvent *event)
+{
+  int step = this->width ()/8;
+
+  switch (event->key ())
+    {
+    case Qt::Key_Plus:
+    case Qt::Key_Equal:
+      this->zoomIn ();
+      break;
+    case Qt::Key_Minus:
+      this->zoomOut ();
+      break;
+    case Qt::Key_0:
+      this->fitBoard ();
+      break;
+    case Qt::Key_Left:
+      this->origin += QPointF (step, 0);
+      this->scroll (step, 0);
+      break;
+    case Qt::Key_Right:
+      this->origin -= QPointF (step, 0);
+      this->scroll (-step, 0);
+      break;
+    case Qt::Key_Up:
+      this->origin += QPointF (0, step);
+      this->scroll (0, step);
+      break;
+    case Qt::Key_Down:
+      this->origin -= QPointF (0, step);
+      this->scroll (0, -step);
+      break;
+    default:
+      QWidget::keyPressEvent (event);
+    }
+}
+
+/**
+ * Repaints the whole board, after a change other than a move, such as a new game, an undo or a load.
+ */
+void BoardWidget::refresh ()
+{
+  this->update ();
+}
+
+/**
+ * Repaints the cells flipped by a move at (x, y).
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ */
+void BoardWidget::refreshMove (int x, int y)
+{
+  // The cell and its neighbours fit in the rectangle from the cell above left of it to the cell below right of it.
+  this->update (this->cellRect (x-1, y-1).united (this->cellRect (x+1, y+1)));
+}
+
+/**
+ * Marks a cell as the hint, the next cell to press, or clears the mark.
+ * @param x Row number of the cell, or 0 to clear the mark.
+ * @param y Column number of the cell, or 0 to clear the mark.
+ */
+void BoardWidget::setHint (int x, int y)
+{
+  if (this->hintX > 0)
+    {
+      this->update (this->hintRect ());
+    }
+  this->hintX = x;
+  this->hintY = y;
+  if (this->hintX > 0)
+    {
+      this->update (this->hintRect ());
+    }
+}
+
+/**
+ * Zooms in by one step around the center of the widget.
+ */
+void BoardWidget::zoomIn ()
+{
+  double size = this->cellSize*BOARDWIDGET_ZOOM_STEP;
+
+  if (size >= BOARDWIDGET_PIXMAP_SIZE && std::floor (size + 0.5) == this->cellSize)
+    {
+      size = this->cellSize + 1;
+    }
+  this->zoomTo (size, QRectF (this->rect ()).center ());
+}
+
+/**
+ * Zooms out by one step around the center of the widget.
+ */
+void BoardWidget::zoomOut ()
+{
+  double size = this->cellSize/BOARDWIDGET_ZOOM_STEP;
+
+  if (size >= BOARDWIDGET_PIXMAP_SIZE && std::floor (size + 0.5) == this->cellSize)
+    {
+      size = this->cellSize - 1;
+    }
+  this->zoomTo (size, QRectF (this->rect ()).center ());
+}
+
+/**
+ * Zooms and pans so that the whole board fits in the widget.
+ */
+void BoardWidget::fitBoard ()
+{
+  if (!this->game)
+    {
+      this->update ();
+      return;
+    }
+
+  int size = this->game->getSize ();
+  int side = this->width () < this->height () ? this->width () : this->height ();
+  double cell = (double) side/size;
+
+  if (cell < BOARDWIDGET_MIN_CELL_SIZE)
+    {
+      cell = BOARDWIDGET_MIN_CELL_SIZE;
+    }
+  if (cell > BOARDWIDGET_MAX_CELL_SIZE)
+    {
+      cell = BOARDWIDGET_MAX_CELL_SIZE;
+    }
+  if (cell >= BOARDWIDGET_PIXMAP_SIZE)
+    {
+      cell = std::floor (cell);
+    }
+
+  this->cellSize = cell;
+  this->origin = QPointF ((this->width () - size*cell)/2, (this->height () - size*cell)/2);
+  this->makePixmaps ();
+  this->update ();
+}
@@ -0,0 +1,241 @@
+/**
+ *@file boardWidget.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class BoardWidget.
+ *@details The BoardWidget class shows the board of a game of blackout and lets the player press cells, zoom and pan.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BOARDWIDGET_H
+#define BOARDWIDGET_H
+
+#include <QWidget>
+#include <QPixmap>
+#include <QPoint>
+#include <QPointF>
+#include <QRect>
+
+#include "blackout.h"
+
+/**
+ * Cells at least this many pixels wide are drawn from cached pixmaps; smaller cells are drawn pixel by pixel, one cell sampled per pixel.
+ */
+#ifndef BOARDWIDGET_PIXMAP_SIZE
+#define BOARDWIDGET_PIXMAP_SIZE 6
+#endif
+
+/**
+ * Largest width of a cell, in pixels.
+ */
+#ifndef BOARDWIDGET_MAX_CELL_SIZE
+#define BOARDWIDGET_MAX_CELL_SIZE 128
+#endif
+
+/**
+ * Smallest width of a cell, in pixels. Below one pixel, several cells share a pixel and only one of them is shown.
+ */
+#ifndef BOARDWIDGET_MIN_CELL_SIZE
+#define BOARDWIDGET_MIN_CELL_SIZE 0.0625
+#endif
+
+/**
+ * Factor by which one step of the mouse wheel zooms.
+ */
+#ifndef BOARDWIDGET_ZOOM_STEP
+#define BOARDWIDGET_ZOOM_STEP 1.25
+#endif
+
+/**
+ * The BoardWidget class draws the board of a game and carries out the moves clicked by the player. A move repaints only the rectangle of the cells it flipped, at most five, so the cost of a move does not depend on the size of the board. Cells of BOARDWIDGET_PIXMAP_SIZE pixels and more are drawn from two cached pixmaps, one per value; smaller cells are sampled into an image covering the repainted rectangle only.
+ * The board is zoomed with the mouse wheel or the + and - keys, around the cursor, and panned by dragging or with the arrow keys.
+ */
+class BoardWidget : public QWidget
+{
+  Q_OBJECT
+
+ private:
+  /**
+   * The game shown, or NULL.
+   */
+  Blackout *game;
+  /**
+   * Width of a cell, in pixels. It is a whole number when cells are drawn from pixmaps.
+   */
+  double cellSize;
+  /**
+   * Position in the widget of the top left corner of the board.
+   */
+  QPointF origin;
+  /**
+   * Pixmap of a cell of value 1, of the size of a cell.
+   */
+  QPixmap litPixmap;
+  /**
+   * Pixmap of a cell of value 0, of the size of a cell.
+   */
+  QPixmap unlitPixmap;
+  /**
+   * Position of the mouse when a button was pressed, or at the last step of a drag.
+   */
+  QPoint pressPosition;
+  /**
+   * Set while the board is dragged.
+   */
+  bool dragging;
+  /**
+   * Row number of the cell marked as a hint, or 0 if there is none.
+   */
+  int hintX;
+  /**
+   * Column number of the cell marked as a hint, or 0 if there is none.
+   */
+  int hintY;
+
+  /**
+   * Redraws the cached pixmaps of the cells at the current cell size.
+   */
+  void makePixmaps ();
+  /**
+   * Returns the rectangle of the widget covered by the cell (x, y).
+   * @param x Row number of the cell.
+   * @param y Column number of the cell.
+   */
+  QRect cellRect (int x, int y);
+  /**
+   * Finds the cell under a point of the widget. The return value is false if the point is outside the board.
+   * @param point The point.
+   * @param x Pointer to the location where the row number of the cell is copied.
+   * @param y Pointer to the location where the column number of the cell is copied.
+   */
+  bool cellAt (const QPoint &point, int *x, int *y);
+  /**
+   * Sets the width of a cell, keeping the point of the board under the given point of the widget in place.
+   * @param size The new width of a cell, limited to the range [BOARDWIDGET_MIN_CELL_SIZE, BOARDWIDGET_MAX_CELL_SIZE].
+   * @param center The point of the widget which stays in place.
+   */
+  void zoomTo (double size, const QPointF &center);
+  /**
+   * Returns the rectangle of the widget covered by the mark of the hint, which is at least a few pixels wide even when the cells are smaller.
+   */
+  QRect hintRect ();
+  /**
+   * Draws the cells that meet a rectangle of the widget from the cached pixmaps.
+   * @param painter The painter of the widget.
+   * @param rect The rectangle.
+   */
+  void paintPixmaps (QPainter *painter, const QRect &rect);
+  /**
+   * Draws a rectangle of the widget pixel by pixel, each pixel showing the cell under its center.
+   * @param painter The painter of the widget.
+   * @param rect The rectangle.
+   */
+  void paintPixels (QPainter *painter, const QRect &rect);
+
+ protected:
+    /**
+     * Repaints the rectangles of the widget that need it.
+     * @param event The paint event, with the region to repaint.
+     */
+    void paintEvent (QPaintEvent *event);
+    /**
+     * Starts a click or a drag.
+     * @param event The mouse event.
+     */
+    void mousePressEvent (QMouseEvent *event);
+    /**
+     * Pans the board while it is dragged.
+     * @param event The mouse event.
+     */
+    void mouseMoveEvent (QMouseEvent *event);
+    /**
+     * Carries out the move at the cell clicked, unless the board was dragged.
+     * @param event The mouse event.
+     */
+    void mouseReleaseEvent (QMouseEvent *event);
+    /**
+     * Zooms around the cursor.
+     * @param event The wheel event.
+     */
+    void wheelEvent (QWheelEvent *event);
+    /**
+     * Zooms with + and -, pans with the arrow keys and fits the board with 0.
+     * @param event The key event.
+     */
+    void keyPressEvent (QKeyEvent *event);
+
+ public:
+    /**
+     * Constructor that creates a widget with no game.
+     * @param parent The parent widget.
+     */
+    explicit BoardWidget (QWidget *parent = 0);
+    /**
+     * Shows a game. The widget does not take ownership of the game.
+     * @param newGame The game, or NULL.
+     */
+    void setGame (Blackout *newGame);
+
+ public slots:
+    /**
+     * Repaints the whole board, after a change other than a move, such as a new game, an undo or a load.
+     */
+    void refresh ();
+    /**
+     * Repaints the cells flipped by a move at (x, y).
+     * @param x Row number of the cell.
+     * @param y Column number of the cell.
+     */
+    void refreshMove (int x, int y);
+    /**
+     * Marks a cell as the hint, the next cell to press, or clears the mark.
+     * @param x Row number of the cell, or 0 to clear the mark.
+     * @param y Column number of the cell, or 0 to clear the mark.
+     */
+    void setHint (int x, int y);
+    /**
+     * Zooms in by one step around the center of the widget.
+     */
+    void zoomIn ();
+    /**
+     * Zooms out by one step around the center of the widget.
+     */
+    void zoomOut ();
+    /**
+     * Zooms and pans so that the whole board fits in the widget.
+     */
+    void fitBoard ();
+
+ signals:
+    /**
+     * Emitted after the player carried out a move.
+     * @param x Row number of the cell.
+     * @param y Column number of the cell.
+     */
+    void moved (int x, int y);
+    /**
+     * Emitted when a move of the player won the game.
+     */
+    void won ();
+};
+
+#endif
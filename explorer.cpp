@@ -0,0 +1,295 @@
+/**
+ *@file explorer.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class StateExplorer.
+ *@details The StateExplorer class explores the complete state space of small boards.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <thread>
+
+#include "explorer.h"
+#include "fixedBoard.h"
+
+/**
+ * Number of frontier words claimed at once by a thread.
+ */
+#ifndef EXPLORE_BLOCK_WORDS
+#define EXPLORE_BLOCK_WORDS 256
+#endif
+
+/**
+ * Constructor that prepares the exploration of a board of the given size.
+ * @param sideLength The side of the square board, at most MAX_EXPLORE_SIZE.
+ * @param threads Number of threads used to expand the frontier. If 0, one per available core.
+ */
+StateExplorer::StateExplorer (int sideLength, int threads) : board (sideLength)
+{
+  this->nThreads = threads;
+  if (this->nThreads <= 0)
+    {
+      this->nThreads = (int) std::thread::hardware_concurrency ();
+    }
+  if (this->nThreads <= 0)
+    {
+      this->nThreads = 1;
+    }
+
+  this->nWords = 0;
+  this->visited = NULL;
+  this->frontier = NULL;
+  this->next = NULL;
+}
+
+/**
+ * Destructor that frees the bit arrays.
+ */
+StateExplorer::~StateExplorer ()
+{
+  delete [] this->visited;
+  delete [] this->frontier;
+  delete [] this->next;
+}
+
+/**
+ * Explores every state reachable from the solved states. The return value is false if the board is too large to be explored.
+ */
+bool StateExplorer::explore ()
+{
+  int n = this->board.getSize ();
+  uint64_t i, full;
+  std::atomic<uint64_t> found;
+  std::atomic<uint64_t> *t;
+  std::vector<std::thread> workers;
+  int k;
+
+  if (n > MAX_EXPLORE_SIZE)
+    {
+      return (false);
+    }
+
+  delete [] this->visited;
+  delete [] this->frontier;
+  delete [] this->next;
+
+  // One bit per state, at least one word
+  this->nWords = ((((uint64_t) 1) << (n*n)) + 63) / 64;
+  this->visited = new std::atomic<uint64_t>[this->nWords];
+  this->frontier = new std::atomic<uint64_t>[this->nWords];
+  this->next = new std::atomic<uint64_t>[this->nWords];
+  for (i=0; i<this->nWords; i++)
+    {
+      this->visited[i].store (0, std::memory_order_relaxed);
+      this->frontier[i].store (0, std::memory_order_relaxed);
+      this->next[i].store (0, std::memory_order_relaxed);
+    }
+
+  // Depth 0: the board with every cell off and the board with every cell on
+  full = this->board.getBoardMask ();
+  this->visited[0].fetch_or (1);
+  this->frontier[0].fetch_or (1);
+  this->visited[full / 64].fetch_or (((uint64_t) 1) << (full % 64));
+  this->frontier[full / 64].fetch_or (((uint64_t) 1) << (full % 64));
+  this->histogram.clear ();
+  this->histogram.push_back (full == 0 ? 1 : 2);
+
+  while (true)
+    {
+      found.store (0);
+      this->nextBlock.store (0);
+
+      workers.clear ();
+      for (k=1; k<this->nThreads; k++)
+	{
+	  workers.push_back (std::thread (&StateExplorer::expand, this, &found));
+	}
+      this->expand (&found);
+      for (k=0; k<(int) workers.size (); k++)
+	{
+	  workers[k].join ();
+	}
+
+      if (found.load () == 0)
+	{
+	  break;
+	}
+      this->histogram.push_back (found.load ());
+
+      // The next level becomes the frontier, and the old frontier is cleared for reuse
+      t = this->frontier;
+      this->frontier = this->next;
+      this->next = t;
+      for (i=0; i<this->nWords; i++)
+	{
+	  this->next[i].store (0, std::memory_order_relaxed);
+	}
+    }
+
+  return (true);
+}
+
+/**
+ * Calls expandWith with the move masks of the FixedBoard of the board size.
+ */
+struct StateExplorer::ExpandJob
+{
+  StateExplorer *explorer;
+  std::atomic<uint64_t> *found;
+
+  template <int N>
+  void run ()
+  {
+    this->explorer->expandWith<N*N> (this->found, FixedBoard<N>::moveMasks (), N*N);
+  }
+};
+
+/**
+ * Expands blocks of the frontier, claimed one after the other, until none is left. The states found are marked in visited and next, and their number is added to found. The move masks are the compile time masks of the FixedBoard of the board size when it has one.
+ * @param found Pointer to the counter of the states found.
+ */
+void StateExplorer::expand (std::atomic<uint64_t> *found)
+{
+  int nCells = this->board.getSize () * this->board.getSize ();
+  uint64_t mask[MAX_EXPLORE_SIZE*MAX_EXPLORE_SIZE];
+  ExpandJob job = { this, found };
+  int c;
+
+  if (dispatchFixedSize (this->board.getSize (), job))
+    {
+      return;
+    }
+
+  for (c=0; c<nCells; c++)
+    {
+      mask[c] = this->board.getMoveMask (c);
+    }
+  this->expandWith<0> (found, mask, nCells);
+}
+
+/**
+ * Expands blocks of the frontier as expand, with nCells moves per state. With nCells known at compile time, the loop over the moves of a state is unrolled.
+ * @param found Pointer to the counter of the states found.
+ * @param mask The move masks of the cells of the board.
+ * @param nCells Number of cells of the board; NCELLS if it is not 0.
+ */
+template <int NCELLS>
+void StateExplorer::expandWith (std::atomic<uint64_t> *found, const uint64_t *mask, int nCells)
+{
+  uint64_t block, w, first, last, bits, state, neighbour, bit, previous;
+  uint64_t count = 0;
+  int c;
+
+  if (NCELLS)
+    {
+      nCells = NCELLS;
+    }
+
+  while (true)
+    {
+      block = this->nextBlock.fetch_add (1);
+      first = block * EXPLORE_BLOCK_WORDS;
+      if (first >= this->nWords)
+	{
+	  break;
+	}
+      last = first + EXPLORE_BLOCK_WORDS;
+      if (last > this->nWords)
+	{
+	  last = this->nWords;
+	}
+
+      for (w=first; w<last; w++)
+	{
+	  bits = this->frontier[w].load (std::memory_order_relaxed);
+	  while (bits)
+	    {
+	      state = w*64 + popCount ((bits & (~bits + 1)) - 1);
+	      bits &= bits - 1;
+
+	      // Every move leads to a state one move further from the solved states, unless it was already found
+	      for (c=0; c<nCells; c++)
+		{
+		  neighbour = state ^ mask[c];
+		  bit = ((uint64_t) 1) << (neighbour % 64);
+		  if (this->visited[neighbour / 64].load (std::memory_order_relaxed) & bit)
+		    {
+		      continue;
+		    }
+		  previous = this->visited[neighbour / 64].fetch_or (bit, std::memory_order_relaxed);
+		  if (!(previous & bit))
+		    {
+		      this->next[neighbour / 64].fetch_or (bit, std::memory_order_relaxed);
+		      count++;
+		    }
+		}
+	    }
+	}
+    }
+
+  found->fetch_add (count);
+}
+
+/**
+ * Returns the number of states whose fewest moves to a solved state is distance.
+ * @param distance The number of moves.
+ */
+uint64_t StateExplorer::getDistanceCount (int distance)
+{
+  if (distance < 0 || distance >= (int) this->histogram.size ())
+    {
+      return (0);
+    }
+  return (this->histogram[distance]);
+}
+
+/**
+ * Returns the largest distance of any state from the solved states, the diameter of the state space.
+ */
+int StateExplorer::getDiameter ()
+{
+  return ((int) this->histogram.size () - 1);
+}
+
+/**
+ * Returns the number of states from which a solved state can be reached.
+ */
+uint64_t StateExplorer::getSolvableStates ()
+{
+  uint64_t total = 0;
+  int i;
+
+  for (i=0; i<(int) this->histogram.size (); i++)
+    {
+      total += this->histogram[i];
+    }
+  return (total);
+}
+
+/**
+ * Returns the number of states of the board, solvable or not.
+ */
+uint64_t StateExplorer::getTotalStates ()
+{
+  int n = this->board.getSize ();
+  return (((uint64_t) 1) << (n*n));
+}
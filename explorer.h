@@ -0,0 +1,139 @@
+/**
+ *@file explorer.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class StateExplorer.
+ *@details The StateExplorer class explores the complete state space of small boards.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EXPLORER_H
+#define EXPLORER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+#include "tools.h"
+#include "board.h"
+
+/**
+ * The largest board side whose state space is explored. A board of side 5 has 2^25 states, whose visited set takes 4 MB.
+ */
+#ifndef MAX_EXPLORE_SIZE
+#define MAX_EXPLORE_SIZE 5
+#endif
+
+/**
+ * The StateExplorer class runs a breadth first search over every state of a board, starting from the solved states (all 0's and all 1's) and following moves with the semantics of Blackout::applyMove. Since every move is its own inverse, the depth at which a state is found is the fewest moves needed to solve it.
+ * The visited set and the frontier are bit arrays indexed by the state, and each level of the search is expanded by all threads at once.
+ */
+class StateExplorer
+{
+ private:
+  /**
+   * The board whose state space is explored.
+   */
+  Board board;
+  /**
+   * Number of threads used to expand the frontier.
+   */
+  int nThreads;
+  /**
+   * Number of 64-bit words in each bit array, one bit per state.
+   */
+  uint64_t nWords;
+  /**
+   * Bit array of the states found so far.
+   */
+  std::atomic<uint64_t> *visited;
+  /**
+   * Bit array of the states found at the current depth.
+   */
+  std::atomic<uint64_t> *frontier;
+  /**
+   * Bit array of the states found at the next depth.
+   */
+  std::atomic<uint64_t> *next;
+  /**
+   * Index of the next block of frontier words to be claimed by a thread.
+   */
+  std::atomic<uint64_t> nextBlock;
+  /**
+   * Number of states found at each depth.
+   */
+  std::vector<uint64_t> histogram;
+
+  /**
+   * Calls expandWith with the move masks of the FixedBoard of the board size.
+   */
+  struct ExpandJob;
+
+  /**
+   * Expands blocks of the frontier, claimed one after the other, until none is left. The states found are marked in visited and next, and their number is added to found. The move masks are the compile time masks of the FixedBoard of the board size when it has one.
+   * @param found Pointer to the counter of the states found.
+   */
+  void expand (std::atomic<uint64_t> *found);
+  /**
+   * Expands blocks of the frontier as expand, with nCells moves per state. With nCells known at compile time, the loop over the moves of a state is unrolled.
+   * @param found Pointer to the counter of the states found.
+   * @param mask The move masks of the cells of the board.
+   * @param nCells Number of cells of the board; NCELLS if it is not 0.
+   */
+  template <int NCELLS>
+  void expandWith (std::atomic<uint64_t> *found, const uint64_t *mask, int nCells);
+
+ public:
+  /**
+   * Constructor that prepares the exploration of a board of the given size.
+   * @param sideLength The side of the square board, at most MAX_EXPLORE_SIZE.
+   * @param threads Number of threads used to expand the frontier. If 0, one per available core.
+   */
+  StateExplorer (int sideLength, int threads=0);
+  /**
+   * Destructor that frees the bit arrays.
+   */
+  ~StateExplorer ();
+  /**
+   * Explores every state reachable from the solved states. The return value is false if the board is too large to be explored.
+   */
+  bool explore ();
+  /**
+   * Returns the number of states whose fewest moves to a solved state is distance.
+   * @param distance The number of moves.
+   */
+  uint64_t getDistanceCount (int distance);
+  /**
+   * Returns the largest distance of any state from the solved states, the diameter of the state space.
+   */
+  int getDiameter ();
+  /**
+   * Returns the number of states from which a solved state can be reached.
+   */
+  uint64_t getSolvableStates ();
+  /**
+   * Returns the number of states of the board, solvable or not.
+   */
+  uint64_t getTotalStates ();
+};
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ *@file explorerMain.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief Command line tool that explores the state space of small boards.
+ *@details For every board size in the range given on the command line, the complete state space is explored from the solved states, and the number of states at each distance from them is printed together with the diameter.
+ *Usage: blackout_explorer [minSize [maxSize [threads]]]
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <chrono>
+
+#include "explorer.h"
+
+int main (int argc, char *argv[])
+{
+  int minSize = 3;
+  int maxSize = MAX_EXPLORE_SIZE;
+  int threads = 0;
+  int size, d;
+
+  if (argc > 1)
+    {
+      minSize = atoi (argv[1]);
+      maxSize = minSize;
+    }
+  if (argc > 2)
+    {
+      maxSize = atoi (argv[2]);
+    }
+  if (argc > 3)
+    {
+      threads = atoi (argv[3]);
+    }
+  if (minSize < 1 || maxSize > MAX_EXPLORE_SIZE || minSize > maxSize)
+    {
+      std::cerr << "Board sizes must be within 1-" << MAX_EXPLORE_SIZE << "\n";
+      std::cerr << "Usage: " << argv[0] << " [minSize [maxSize [threads]]]\n";
+      return (1);
+    }
+
+  // One line per size with the totals, followed by one line per distance
+  std::cout << "# size states solvable diameter seconds\n";
+  std::cout << "# size distance count\n";
+  for (size=minSize; size<=maxSize; size++)
+    {
+      StateExplorer explorer (size, threads);
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+      explorer.explore ();
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+
+      std::cout << size << " " << explorer.getTotalStates () << " " << explorer.getSolvableStates () << " " << explorer.getDiameter () << " " << elapsed.count () << "\n";
+      for (d=0; d<=explorer.getDiameter (); d++)
+	{
+	  std::cout << size << " " << d << " " << explorer.getDistanceCount (d) << "\n";
+	}
+    }
+
+  return (0);
+}
@@ -0,0 +1,482 @@
+/**
+ *@file fixedBoard.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class templates FixedBoard and FixedBlackout.
+ *@details The FixedBoard and FixedBlackout class templates are boards and games whose size is known at compile time.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIXEDBOARD_H
+#define FIXEDBOARD_H
+
+#include <stdint.h>
+
+#include "tools.h"
+#include "board.h"
+#include "solver.h"
+#include "blackout.h"
+
+/**
+ * The smallest board size with a fixed size class. Smaller boards are played by the Board and Blackout classes.
+ */
+#ifndef MIN_FIXED_BOARDSIZE
+#define MIN_FIXED_BOARDSIZE 3
+#endif
+
+/**
+ * Returns the mask of the cells of a packed board of side n in the column made of bit row*n and the bits n, 2n, ... above it: with row 0, the first column.
+ * @param n The side of the board.
+ * @param row The row from which the column starts, counted from 0.
+ */
+constexpr uint64_t fixedColumnMask (int n, int row)
+{
+  return ((row >= n) ? 0 : ((((uint64_t) 1) << (row*n)) | fixedColumnMask (n, row+1)));
+}
+
+/**
+ * Returns the mask of every cell of a packed board of side n.
+ * @param n The side of the board.
+ */
+constexpr uint64_t fixedBoardMask (int n)
+{
+  return ((n*n >= 64) ? ~((uint64_t) 0) : ((((uint64_t) 1) << (n*n)) - 1));
+}
+
+/**
+ * Returns the cells flipped by a set of presses on a packed board of side n, with the moves of Blackout::applyMove: each press flips its cell and the cells above, below, to the left and to the right of it that are on the board.
+ * @param n The side of the board.
+ * @param presses The cells pressed, the cell (x, y) in the bit (x-1)*n + (y-1).
+ */
+constexpr uint64_t fixedPressStencil (int n, uint64_t presses)
+{
+  // The cell above is n bits lower, the cell to the left one bit lower; shifts across a row end are masked off
+  return ((presses ^ (presses << n) ^ (presses >> n)
+	   ^ ((presses << 1) & ~fixedColumnMask (n, 0))
+	   ^ ((presses >> 1) & ~(fixedColumnMask (n, 0) << (n-1)))) & fixedBoardMask (n));
+}
+
+/**
+ * A list of cell indices, built by MakeFixedCells, that expands into the initializer of a table.
+ */
+template <int... Cells>
+struct FixedCells
+{
+};
+
+/**
+ * Builds FixedCells<0, 1, ..., K-1>.
+ */
+template <int K, int... Cells>
+struct MakeFixedCells : MakeFixedCells<K-1, K-1, Cells...>
+{
+};
+
+template <int... Cells>
+struct MakeFixedCells<0, Cells...>
+{
+  typedef FixedCells<Cells...> type;
+};
+
+/**
+ * The move masks of every cell of a packed board of side N, computed at compile time.
+ */
+template <int N, class Cells = typename MakeFixedCells<N*N>::type>
+struct FixedMoveTable;
+
+template <int N, int... Cells>
+struct FixedMoveTable<N, FixedCells<Cells...> >
+{
+  static constexpr uint64_t mask[N*N] = { fixedPressStencil (N, ((uint64_t) 1) << Cells)... };
+};
+
+template <int N, int... Cells>
+constexpr uint64_t FixedMoveTable<N, FixedCells<Cells...> >::mask[N*N];
+
+/**
+ * The FixedBoard class template is a packed board, as the Board class for sides up to MAX_BOARDSIZE, whose side N is a template parameter. The masks of the board and of every move are compile time constants and the loops over cells are replaced by whole word operations, so a move is a bounds check and one XOR with a constant of the table, and pressing a set of cells is a fixed sequence of shifts, with no branch on the edges of the board.
+ * The cell (x, y) is the bit (x-1)*N + (y-1) of the state, as in the Board class.
+ */
+template <int N>
+class FixedBoard
+{
+  static_assert (N >= 1 && N <= MAX_BOARDSIZE, "a fixed board is packed in one word");
+
+ private:
+  /**
+   * The current state of the board.
+   */
+  uint64_t cell;
+  /**
+   * The state of the board at the start of the game.
+   */
+  uint64_t initialCell;
+
+ public:
+    /**
+     * The side of the board.
+     */
+    static constexpr int size = N;
+    /**
+     * Mask with one bit set for every cell of the board.
+     */
+    static constexpr uint64_t boardMask = fixedBoardMask (N);
+
+    /**
+     * Constructor that creates the board with all cells set to 0.
+     */
+    FixedBoard () : cell (0), initialCell (0)
+    {
+    }
+    /**
+     * Returns the mask of the cells flipped by a move at the cell of the given index, (x-1)*N + (y-1).
+     * @param index Index of the cell, in [0, N*N).
+     */
+    static constexpr uint64_t moveMask (int index)
+    {
+      return (fixedPressStencil (N, ((uint64_t) 1) << index));
+    }
+    /**
+     * Returns the table of the move masks of every cell, indexed as moveMask.
+     */
+    static const uint64_t *moveMasks ()
+    {
+      return (FixedMoveTable<N>::mask);
+    }
+    /**
+     * Presses the cell at (x, y), flipping it and its neighbours. The return value is false if the co-ordinates are not on the board.
+     * @param x Row number of the cell.
+     * @param y Column number of the cell.
+     */
+    bool pressCell (int x, int y)
+    {
+      // Both co-ordinates are checked by one unsigned comparison each
+      if ((unsigned) (x-1) >= (unsigned) N || (unsigned) (y-1) >= (unsigned) N)
+	{
+	  return (false);
+	}
+      this->cell ^= FixedMoveTable<N>::mask[(x-1)*N + (y-1)];
+      return (true);
+    }
+    /**
+     * Presses the cell of the given index without checking it.
+     * @param index Index of the cell, in [0, N*N).
+     */
+    void press (int index)
+    {
+      this->cell ^= FixedMoveTable<N>::mask[index];
+    }
+    /**
+     * Presses every cell set in presses at once.
+     * @param presses The cells pressed. Bits outside the board are ignored.
+     */
+    void pressCells (uint64_t presses)
+    {
+      this->cell ^= fixedPressStencil (N, presses & boardMask);
+    }
+    /**
+     * Flips the value of the cell at (x, y) alone. The return value is false if the co-ordinates are not on the board.
+     * @param x Row number of the cell.
+     * @param y Column number of the cell.
+     */
+    bool flipCell (int x, int y)
+    {
+      if ((unsigned) (x-1) >= (unsigned) N || (unsigned) (y-1) >= (unsigned) N)
+	{
+	  return (false);
+	}
+      this->cell ^= ((uint64_t) 1) << ((x-1)*N + (y-1));
+      return (true);
+    }
+    /**
+     * Returns the current state of the board.
+     */
+    uint64_t getState ()
+    {
+      return (this->cell);
+    }
+    /**
+     * Sets the current state of the board. Bits outside the board are ignored.
+     * @param state The new state.
+     */
+    void setState (uint64_t state)
+    {
+      this->cell = state & boardMask;
+    }
+    /**
+     * Returns the state of the board at the start of the game.
+     */
+    uint64_t getInitialState ()
+    {
+      return (this->initialCell);
+    }
+    /**
+     * Saves the current state as the initial state.
+     */
+    void setInitialState ()
+    {
+      this->initialCell = this->cell;
+    }
+    /**
+     * Resets the board to its initial state.
+     */
+    void resetBoard ()
+    {
+      this->cell = this->initialCell;
+    }
+    /**
+     * Returns the number of cells set to 1.
+     */
+    int sum ()
+    {
+      return (popCount (this->cell));
+    }
+    /**
+     * Returns true if every cell is 0 or every cell is 1.
+     */
+    bool isWon ()
+    {
+      return (this->cell == 0 || this->cell == boardMask);
+    }
+};
+
+template <int N>
+constexpr int FixedBoard<N>::size;
+
+template <int N>
+constexpr uint64_t FixedBoard<N>::boardMask;
+
+/**
+ * The FixedBlackout class template is the game of the Blackout class on a FixedBoard of side N, for the tools that play many games of one size: it has the same moves, generation, win condition and solver, but no move journal, no files and no instrumentation, so a move is inlined into the caller as a few instructions.
+ */
+template <int N>
+class FixedBlackout
+{
+ private:
+  /**
+   * The board on which the game is played.
+   */
+  FixedBoard<N> board;
+  /**
+   * Solver for the boards of side N, shared with the Blackout class.
+   */
+  Solver *solver;
+  /**
+   * Keeps count of the number of moves.
+   */
+  int nMoves;
+
+ public:
+    /**
+     * Constructor that creates the game with all cells set to 0.
+     */
+    FixedBlackout () : solver (Solver::forSize (N)), nMoves (0)
+    {
+    }
+    /**
+     * Starts a new game from the given state. The state becomes the initial state and the move count is cleared.
+     * @param state The state of the board, with the cell (x, y) in the bit (x-1)*N + (y-1).
+     */
+    void newGame (uint64_t state)
+    {
+      this->board.setState (state);
+      this->board.setInitialState ();
+      this->nMoves = 0;
+    }
+    /**
+     * Generates a new game from a uniform random set of presses, as Blackout::generateGame. The return value is false if maxAttempts states were drawn and all were already won.
+     * @param maxAttempts Number of states drawn before giving up. Default value: GAME_GENERATION_ATTEMPTS.
+     */
+    bool generateGame (int maxAttempts=GAME_GENERATION_ATTEMPTS)
+    {
+      int attempt;
+
+      for (attempt=0; attempt<maxAttempts; attempt++)
+	{
+	  this->board.setState (0);
+	  this->board.pressCells (getRandomWord ());
+	  if (!this->board.isWon ())
+	    {
+	      this->newGame (this->board.getState ());
+	      return (true);
+	    }
+	}
+      return (false);
+    }
+    /**
+     * Carries out the move at (x, y). The return value is false if the co-ordinates are not on the board.
+     * @param x Row number of the point where the move is carried out.
+     * @param y Column number of the point where the move is carried out.
+     */
+    bool applyMove (int x, int y)
+    {
+      if (!this->board.pressCell (x, y))
+	{
+	  return (false);
+	}
+      (this->nMoves)++;
+      return (true);
+    }
+    /**
+     * Presses every cell set in a press pattern at once, as Blackout::applyPresses. The return value is the number of presses.
+     * @param presses The press pattern, one word.
+     */
+    int64_t applyPresses (const uint64_t *presses)
+    {
+      int nPresses = popCount (presses[0] & FixedBoard<N>::boardMask);
+
+      this->board.pressCells (presses[0]);
+      this->nMoves += nPresses;
+      return (nPresses);
+    }
+    /**
+     * Returns true if the board is won: all 0's or all 1's.
+     */
+    bool checkWinCondition ()
+    {
+      return (this->board.isWon ());
+    }
+    /**
+     * Resets the game to its initial state.
+     */
+    void reset ()
+    {
+      this->board.resetBoard ();
+      this->nMoves = 0;
+    }
+    /**
+     * Finds the set of cells to press to reach a winning state, as Blackout::solve. The return value is false if the current state cannot be solved.
+     * @param presses Pointer to the location where the set of cells to press is copied.
+     * @param method The method used to solve the board. Default value: SOLVE_CHASE.
+     */
+    bool solve (uint64_t *presses, SolverMethod method=SOLVE_CHASE)
+    {
+      uint64_t state = this->board.getState ();
+      uint64_t toOn;
+      bool offSolved, onSolved;
+
+      if (method == SOLVE_OPTIMAL)
+	{
+	  offSolved = this->solver->solve (state, presses, method);
+	  onSolved = this->solver->solve (state ^ FixedBoard<N>::boardMask, &toOn, method);
+	  if (onSolved && (!offSolved || popCount (toOn) < popCount (*presses)))
+	    {
+	      *presses = toOn;
+	    }
+	  return (offSolved || onSolved);
+	}
+      return (this->solver->solve (state, presses, method) || this->solver->solve (state ^ FixedBoard<N>::boardMask, presses, method));
+    }
+    /**
+     * Returns the fewest moves needed to win the game from its initial state, or -1 if it cannot be solved, as Blackout::getOptimalMoves.
+     */
+    int getOptimalMoves ()
+    {
+      uint64_t state = this->board.getInitialState ();
+      uint64_t toOff, toOn;
+      bool offSolved = this->solver->solveOptimal (state, &toOff);
+      bool onSolved = this->solver->solveOptimal (state ^ FixedBoard<N>::boardMask, &toOn);
+
+      if (offSolved && onSolved)
+	{
+	  return (popCount (toOff) < popCount (toOn) ? popCount (toOff) : popCount (toOn));
+	}
+      if (offSolved)
+	{
+	  return (popCount (toOff));
+	}
+      if (onSolved)
+	{
+	  return (popCount (toOn));
+	}
+      return (-1);
+    }
+    /**
+     * Returns the side of the board.
+     */
+    int getSize ()
+    {
+      return (N);
+    }
+    /**
+     * Returns the current state of the board.
+     */
+    uint64_t getState ()
+    {
+      return (this->board.getState ());
+    }
+    /**
+     * Returns the state of the board at the start of the game.
+     */
+    uint64_t getInitialState ()
+    {
+      return (this->board.getInitialState ());
+    }
+    /**
+     * Returns the number of moves carried out.
+     */
+    int getMoves ()
+    {
+      return (this->nMoves);
+    }
+};
+
+/**
+ * Calls job.run<N> () for the side N equal to size, if it is within [N, MAX_GAMESQUARESIZE]: the one point where a board size known at run time becomes a compile time constant. The return value is false if no fixed size matches, in which case the caller falls back to the Board and Blackout classes.
+ */
+template <int N>
+struct FixedSizeDispatch
+{
+  template <class Job>
+  static bool run (int size, Job &job)
+  {
+    if (size == N)
+      {
+	job.template run<N> ();
+	return (true);
+      }
+    return (FixedSizeDispatch<N+1>::run (size, job));
+  }
+};
+
+template <>
+struct FixedSizeDispatch<MAX_GAMESQUARESIZE+1>
+{
+  template <class Job>
+  static bool run (int, Job &)
+  {
+    return (false);
+  }
+};
+
+/**
+ * Calls job.run<N> () with N equal to size, for the sizes from MIN_FIXED_BOARDSIZE to MAX_GAMESQUARESIZE. The return value is false for any other size.
+ * @param size The side of the board, known at run time.
+ * @param job An object with a member template run<N> ().
+ */
+template <class Job>
+bool dispatchFixedSize (int size, Job &job)
+{
+  return (FixedSizeDispatch<MIN_FIXED_BOARDSIZE>::run (size, job));
+}
+
+#endif
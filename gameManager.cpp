@@ -37,6 +37,13 @@ void play ()
   int choice;    // Stores the choice of the user from the menu
   bool menuContinue = true;
   int boardSize;
+  std::string ruleName;
+  Neighbourhood rule;
+
+  if (getenv (TRACE_ENVIRONMENT_VARIABLE))
+    {
+      Instrumentation::setEnabled (true);
+    }
 
   while (menuContinue)
     {
@@ -47,6 +54,7 @@ void play ()
 	{
 	case 0:
 	  // Exit the game
+	  writeTrace ();
 	  if (!bl)
 	    {
 	      // Clear memory
@@ -78,8 +86,20 @@ void play ()
 	  // New game with custom board size
 	  std::cout << "Board size (" << DEFAULT_GAMESQUARESIZE << "-" << MAX_GAMESQUARESIZE << ")? ";
 	  std::cin >> boardSize;
+	  if (boardSize > MAX_GAMESQUARESIZE)
+	    {
+	      // Moves are typed as rowcolumn, one digit each, so large boards are not played here
+	      boardSize = MAX_GAMESQUARESIZE;
+	    }
+	  std::cout << "Rule (plus, torus, king, knight, or offsets such as 0,0;1,1;-1,-1 with a leading @ to wrap around)? ";
+	  std::cin >> ruleName;
+	  if (!rule.parse (ruleName.c_str ()))
+	    {
+	      std::cout << "Unknown rule, playing plus\n";
+	      rule = Neighbourhood (RULE_PLUS);
+	    }
 
-	  bl = new Blackout (boardSize);
+	  bl = new Blackout (boardSize, rule);
 	  if (!bl->generateGame())
 	    {
 	      std::cout << "\nFailed to generate game\n";
@@ -95,23 +115,35 @@ void play ()
 
 	case 3:
 	  // Load previous game
-	  bl = new Blackout ();
-	  if (loadGameData (bl))
+	  bl = loadGameData ();
+	  if (bl)
 	    {
 	      game (bl);
 	    }
 	  else
 	    {
 	      std::cout << "Error loading file.\n";
-	      // Clear memory
-	      delete (bl);
-	      bl = NULL;
+	    }
+	  menuContinue = true;
+	  break;
+
+	case 4:
+	  // New game from a puzzle bank
+	  bl = bankGame ();
+	  if (bl)
+	    {
+	      game (bl);
+	    }
+	  else
+	    {
+	      std::cout << "Error loading puzzle.\n";
 	    }
 	  menuContinue = true;
 	  break;
 
 	default:
 	  // Exit the game
+	  writeTrace ();
 	  if (!bl)
 	    {
 	      // Clear memory
@@ -136,7 +168,8 @@ int showMenu ()
   std::cout << "1. New game (default " << DEFAULT_GAMESQUARESIZE << "x" << DEFAULT_GAMESQUARESIZE << "board)\n";
   std::cout << "2. New game (custom board size)\n";
   std::cout << "3. Load saved game\n";
-  std::cout << "Enter choice (anything other than 1, 2 or 3 to exit): ";
+  std::cout << "4. New game from a puzzle bank\n";
+  std::cout << "Enter choice (anything other than 1, 2, 3 or 4 to exit): ";
 
   int ch;
 
@@ -145,17 +178,52 @@ int showMenu ()
 }
 
 /**
- * Loads the game data into the memory pointed to by Blackout *bl. The return value is true of the load is successful, else it is false.
- * @param bl Pointer to the object of the Blackout class into which game data is to be loaded.
+ * Asks the user for a save file and loads the game from it, with the board size recorded in the file, up to MAX_GAMESQUARESIZE. The return value is the game loaded, or NULL if the load is unsuccessful.
  */
-bool loadGameData (Blackout *bl)
+Blackout *loadGameData ()
 {
   std::string fName;
 
   std::cout << "Enter file name: ";
   std::cin >> fName;
 
-  return (bl->loadGame(fName.c_str()));
+  // Moves are typed as rowcolumn, one digit each, so large boards are not loaded here
+  return (Blackout::fromFile (fName.c_str(), isBinaryFile (fName), MAX_GAMESQUARESIZE));
+}
+
+/**
+ * Starts a new game with a random puzzle from a puzzle bank. The bank file, the board size and the difficulty are asked to the user. The return value is the new game, or NULL if no such puzzle was found.
+ */
+Blackout *bankGame ()
+{
+  PuzzleBank bank;
+  std::string fName;
+  int boardSize, difficulty;
+  uint64_t state;
+  Blackout *bl;
+
+  std::cout << "Enter bank file name: ";
+  std::cin >> fName;
+  if (!bank.open (fName.c_str()))
+    {
+      return (NULL);
+    }
+
+  std::cout << "Board size (" << DEFAULT_GAMESQUARESIZE << "-" << MAX_GAMESQUARESIZE << ")? ";
+  std::cin >> boardSize;
+  std::cout << "Difficulty (0-" << bank.getMaxDifficulty (boardSize) << " moves)? ";
+  std::cin >> difficulty;
+
+  // Timed once the choices are read, so that the time of the player is not counted
+  ScopedTimer timer (OP_NEW_GAME);
+  if (!bank.getRandomPuzzle (boardSize, difficulty, &state))
+    {
+      return (NULL);
+    }
+
+  bl = new Blackout (boardSize);
+  bl->newGame (state);
+  return (bl);
 }
 
 /**
@@ -173,12 +241,13 @@ void game (Blackout *bl)
       if (bl->show())
 	{
 	  std::cout << "\nNumber of moves: " << bl->getMoves ();
-	  std::cout << "\nr:reset|s:save|l:load|q:quit";
+	  std::cout << "\nr:reset|s:save|l:load|u:undo|d:redo|h:hint|t:trace|q:quit";
 	  std::cout << "\nYour move (rowcolumn): ";
 	  std::cin >> m;
 
 	  xy = decipherInput (m);
 
+	  // Quitting, saving and loading wait for the answers of the player, so they are not timed as turns
 	  switch (xy)
 	    {
 	    case 0:
@@ -187,18 +256,52 @@ void game (Blackout *bl)
 		{
 		  return;
 		}
-	      break;
-	    case -1:
-	      // Reset game
-	      reset (bl);
-	      break;
+	      continue;
 	    case -2:
 	      // Save game
 	      save (bl, "");
-	      break;
+	      continue;
 	    case -3:
 	      // Load game
 	      load (bl);
+	      continue;
+	    }
+
+	  ScopedTimer timer (OP_TURN);
+	  switch (xy)
+	    {
+	    case -1:
+	      // Reset game
+	      reset (bl);
+	      break;
+	    case -4:
+	      // Undo move
+	      if (!bl->undo ())
+		{
+		  std::cout << "\nNothing to undo.\n";
+		}
+	      break;
+	    case -5:
+	      // Redo move
+	      if (!bl->redo ())
+		{
+		  std::cout << "\nNothing to redo.\n";
+		}
+	      break;
+	    case -6:
+	      // Switch the instrumentation on or off
+	      toggleTrace ();
+	      break;
+	    case -7:
+	      // Next cell of the solution kept by the game
+	      if (bl->getHint (&x, &y))
+		{
+		  std::cout << "\nPress " << x << y << ", " << bl->getMovesRemaining () << " moves to go.\n";
+		}
+	      else
+		{
+		  std::cout << "\nNo hint: this game cannot be won from here.\n";
+		}
 	      break;
 	    default:
 	      // Standard move
@@ -228,6 +331,7 @@ void game (Blackout *bl)
     {
       // The game was won!
       std::cout << "\nCongratulations! You cracked the game in " << bl->getMoves() << " moves!\n";
+      std::cout << "The best possible was " << bl->getOptimalMoves() << " moves.\n";
     }
 }
 
@@ -238,6 +342,10 @@ void game (Blackout *bl)
  * -1: Reset game
  * -2: Save game
  * -3: Load game
+ * -4: Undo move
+ * -5: Redo move
+ * -6: Switch the instrumentation on or off
+ * -7: Hint
  * None of the above: move
  */
 int decipherInput (std::string m)
@@ -268,6 +376,30 @@ int decipherInput (std::string m)
       return (-3);
     }
 
+  if (input[0] == 'u')
+    {
+      // Undo move
+      return (-4);
+    }
+
+  if (input[0] == 'd')
+    {
+      // Redo move
+      return (-5);
+    }
+
+  if (input[0] == 't')
+    {
+      // Switch the instrumentation on or off
+      return (-6);
+    }
+
+  if (input[0] == 'h')
+    {
+      // Hint
+      return (-7);
+    }
+
   // If we are still here, then it is a move
   int move = atoi(input);
 
@@ -295,10 +427,26 @@ void save (Blackout *bl, std::string question)
     }
 
   std::string fileName;
+  bool saved;
 
-  std::cout << "Filename: ";
+  if (!bl->getNeighbourhood ().isPlus ())
+    {
+      // The save files have no room for the rule, and would reload as a plus rule game
+      std::cout << "\nGames of the " << bl->getNeighbourhood ().getName () << " rule cannot be saved.\n";
+      return;
+    }
+
+  std::cout << "Filename (" << BINARY_SAVE_EXTENSION << " for the binary format): ";
   std::cin >> fileName;
-  if (bl->saveGame (fileName.c_str()))
+  if (isBinaryFile (fileName))
+    {
+      saved = bl->saveGameBinary (fileName.c_str());
+    }
+  else
+    {
+      saved = bl->saveGame (fileName.c_str());
+    }
+  if (saved)
     {
       std::cout << "\nSave successful!\n";
     }
@@ -315,10 +463,19 @@ void save (Blackout *bl, std::string question)
 void load (Blackout *bl)
 {
   std::string fileName;
+  bool loaded;
 
   std::cout << "Filename: ";
   std::cin >> fileName;
-  if (bl->loadGame (fileName.c_str()))
+  if (isBinaryFile (fileName))
+    {
+      loaded = bl->loadGameBinary (fileName.c_str());
+    }
+  else
+    {
+      loaded = bl->loadGame (fileName.c_str());
+    }
+  if (loaded)
     {
       std::cout << "\nLoad successful!\n";
 		}
@@ -345,6 +502,17 @@ void reset (Blackout *bl)
     }
 }
   
+/**
+ * Returns whether the file with the given name is saved in the binary format, that is whether its name ends with BINARY_SAVE_EXTENSION.
+ * @param fileName Name of the file.
+ */
+bool isBinaryFile (std::string fileName)
+{
+  std::string extension = BINARY_SAVE_EXTENSION;
+
+  return (fileName.size() >= extension.size() && fileName.compare (fileName.size() - extension.size(), extension.size(), extension) == 0);
+}
+
 /**
  * Quits the game.
  * @param bl Pointer to game data
@@ -367,3 +535,52 @@ bool quit (Blackout *bl)
     }
 }
 
+
+/**
+ * Returns the name of the trace file: the value of TRACE_ENVIRONMENT_VARIABLE if it is set, else DEFAULT_TRACE_FILE.
+ */
+const char *getTraceFile ()
+{
+  const char *fileName = getenv (TRACE_ENVIRONMENT_VARIABLE);
+
+  if (!fileName || !fileName[0])
+    {
+      return (DEFAULT_TRACE_FILE);
+    }
+  return (fileName);
+}
+
+/**
+ * Switches the instrumentation on or off. When it is switched off, the trace is written to the trace file.
+ */
+void toggleTrace ()
+{
+  if (!Instrumentation::isEnabled ())
+    {
+      Instrumentation::setEnabled (true);
+      std::cout << "\nInstrumentation on.\n";
+      return;
+    }
+
+  Instrumentation::setEnabled (false);
+  if (Instrumentation::exportTrace (getTraceFile ()))
+    {
+      std::cout << "\nInstrumentation off, trace written to " << getTraceFile () << "\n";
+    }
+  else
+    {
+      std::cout << "\nInstrumentation off, trace could not be written to " << getTraceFile () << "\n";
+    }
+}
+
+/**
+ * Writes the trace to the trace file, if the instrumentation is on. This is called when the game exits.
+ */
+void writeTrace ()
+{
+  if (Instrumentation::isEnabled ())
+    {
+      Instrumentation::setEnabled (false);
+      Instrumentation::exportTrace (getTraceFile ());
+    }
+}
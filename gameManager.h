@@ -32,6 +32,22 @@
 #include <string>
 
 #include "blackout.h"
+#include "puzzleBank.h"
+#include "instrumentation.h"
+
+/**
+ * Environment variable which, when set, switches the instrumentation on from the start and names the trace file.
+ */
+#ifndef TRACE_ENVIRONMENT_VARIABLE
+#define TRACE_ENVIRONMENT_VARIABLE "BLACKOUT_TRACE"
+#endif
+
+/**
+ * Name of the trace file if TRACE_ENVIRONMENT_VARIABLE is not set.
+ */
+#ifndef DEFAULT_TRACE_FILE
+#define DEFAULT_TRACE_FILE "blackout_trace.json"
+#endif
 
 /**
  * Function to start the game. This is called by the main() function.
@@ -50,10 +66,14 @@ int showMenu ();
 void game (Blackout *bl);
 
 /**
- * Loads the game data into the memory pointed to by Blackout *bl. The return value is true of the load is successful, else it is false.
- * @param bl Pointer to the object of the Blackout class into which game data is to be loaded.
+ * Asks the user for a save file and loads the game from it, with the board size recorded in the file, up to MAX_GAMESQUARESIZE. The return value is the game loaded, or NULL if the load is unsuccessful.
+ */
+Blackout *loadGameData ();
+
+/**
+ * Starts a new game with a random puzzle from a puzzle bank. The bank file, the board size and the difficulty are asked to the user. The return value is the new game, or NULL if no such puzzle was found.
  */
-bool loadGameData (Blackout *bl);
+Blackout *bankGame ();
 
 /**
  * Deciphers the input from the user.
@@ -62,6 +82,10 @@ bool loadGameData (Blackout *bl);
  * -1: Reset game
  * -2: Save game
  * -3: Load game
+ * -4: Undo move
+ * -5: Redo move
+ * -6: Switch the instrumentation on or off
+ * -7: Hint
  * None of the above: move
  */
 int decipherInput (std::string m);
@@ -85,10 +109,31 @@ void load (Blackout *bl);
  */
 void reset (Blackout *bl);
 
+/**
+ * Returns whether the file with the given name is saved in the binary format, that is whether its name ends with BINARY_SAVE_EXTENSION.
+ * @param fileName Name of the file.
+ */
+bool isBinaryFile (std::string fileName);
+
 /**
  * Quits the game.
  * @param bl Pointer to game data
  */
 bool quit (Blackout *bl);
 
+/**
+ * Returns the name of the trace file: the value of TRACE_ENVIRONMENT_VARIABLE if it is set, else DEFAULT_TRACE_FILE.
+ */
+const char *getTraceFile ();
+
+/**
+ * Switches the instrumentation on or off. When it is switched off, the trace is written to the trace file.
+ */
+void toggleTrace ();
+
+/**
+ * Writes the trace to the trace file, if the instrumentation is on. This is called when the game exits.
+ */
+void writeTrace ();
+
 #endif
@@ -0,0 +1,301 @@
+/**
+ *@file gameWorker.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class GameWorker.
+ *@details The GameWorker class runs the solver and the generator of the GUI on a pool of threads.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gameWorker.h"
+
+#include <QMetaType>
+#include <QRunnable>
+
+/**
+ * Finds the presses that win a state of the board, switching every cell off or, failing that, on. The return value is false if the state cannot be won.
+ * @param size The side of the board.
+ * @param rule The cells flipped by a move. Large boards are only solved for the plus rule.
+ * @param state The state, in the layout of Blackout::snapshot.
+ * @param presses Pointer to the location where the presses are copied, resized to the words of the state.
+ */
+static bool solveState (int size, const Neighbourhood &rule, const PressSet &state, PressSet *presses)
+{
+  presses->assign (state.size (), 0);
+
+  if (size > MAX_BOARDSIZE)
+    {
+      if (!rule.isPlus ())
+	{
+	  return (false);
+	}
+      LargeSolver *largeSolver = LargeSolver::forSize (size);
+      return (largeSolver && (largeSolver->solve (state.data (), presses->data ()) || largeSolver->solve (state.data (), presses->data (), true)));
+    }
+
+  Solver *solver = Solver::forNeighbourhood (size, rule);
+  return (solver && (solver->solve (state[0], &(*presses)[0], SOLVE_CHASE) || solver->solve (state[0] ^ solver->getBoardMask (), &(*presses)[0], SOLVE_CHASE)));
+}
+
+/**
+ * Finds the cell of the first press of a set, in reading order. The return value is false if the set is empty.
+ * @param size The side of the board.
+ * @param presses The presses, in the layout of Blackout::snapshot.
+ * @param x Pointer to the location where the row number of the cell is copied.
+ * @param y Pointer to the location where the column number of the cell is copied.
+ */
+static bool firstPress (int size, const PressSet &presses, int *x, int *y)
+{
+  size_t rowWords = (size > MAX_BOARDSIZE) ? (size + 63) / 64 : 1;
+  size_t w;
+  int bit;
+
+  for (w=0; w<presses.size (); w++)
+    {
+      if (presses[w] == 0)
+	{
+	  continue;
+	}
+      for (bit=0; !((presses[w] >> bit) & 1); bit++)
+	;
+      if (size > MAX_BOARDSIZE)
+	{
+	  *x = (int) (w / rowWords) + 1;
+	  *y = (int) (w % rowWords) * 64 + bit + 1;
+	}
+      else
+	{
+	  *x = bit / size + 1;
+	  *y = bit % size + 1;
+	}
+      return (true);
+    }
+  return (false);
+}
+
+/**
+ * A task that solves a copy of the state of a board, for a solution or a hint.
+ */
+class SolveTask : public QRunnable
+{
+ private:
+  GameWorker *worker;
+  int generation;
+  bool hint;
+  int size;
+  Neighbourhood rule;
+  PressSet state;
+
+ public:
+  SolveTask (GameWorker *owner, int requestGeneration, bool forHint, Blackout *game) :
+    worker (owner), generation (requestGeneration), hint (forHint), size (game->getSize ()), rule (game->getNeighbourhood ()), state (game->getPressWords ())
+  {
+    game->snapshot (this->state.data ());
+  }
+
+  void run ()
+  {
+    PressSet presses;
+    bool solved;
+
+    // A request cancelled while it waited in the queue is dropped without solving
+    if (!this->worker->isCurrent (this->generation))
+      {
+	return;
+      }
+    solved = solveState (this->size, this->rule, this->state, &presses);
+    this->worker->finishSolution (this->generation, this->hint, this->size, solved, presses);
+  }
+};
+
+/**
+ * A task that generates and rates a new game.
+ */
+class GenerateTask : public QRunnable
+{
+ private:
+  GameWorker *worker;
+  int generation;
+  int size;
+
+ public:
+  GenerateTask (GameWorker *owner, int requestGeneration, int boardSize) :
+    worker (owner), generation (requestGeneration), size (boardSize)
+  {
+  }
+
+  void run ()
+  {
+    Blackout *game;
+    int par;
+
+    if (!this->worker->isCurrent (this->generation))
+      {
+	return;
+      }
+
+    game = new Blackout (this->size);
+    if (!game->generateGame ())
+      {
+	delete (game);
+	this->worker->finishGame (this->generation, NULL, -1);
+	return;
+      }
+
+    // The fewest moves are only known for packed boards; a large board is rated by the presses of the solution found
+    par = game->getOptimalMoves ();
+    if (par < 0)
+      {
+	PressSet state (game->getPressWords ());
+	PressSet presses;
+	game->snapshot (state.data ());
+	if (solveState (game->getSize (), game->getNeighbourhood (), state, &presses))
+	  {
+	    par = (int) popCountWords (presses.data (), presses.size ());
+	  }
+      }
+    this->worker->finishGame (this->generation, game, par);
+  }
+};
+
+/**
+ * Constructor that creates the pool of threads, with one thread per core.
+ * @param parent The parent object.
+ */
+GameWorker::GameWorker (QObject *parent) : QObject (parent)
+{
+  this->generation = 0;
+  this->pool = new QThreadPool (this);
+
+  qRegisterMetaType<PressSet> ("PressSet");
+  qRegisterMetaType<Blackout *> ("Blackout*");
+}
+
+/**
+ * Destructor that cancels the pending requests and waits for the running tasks to finish.
+ */
+GameWorker::~GameWorker ()
+{
+  this->cancel ();
+  this->pool->waitForDone ();
+}
+
+/**
+ * Cancels every pending request and returns the new generation.
+ */
+int GameWorker::cancel ()
+{
+  return (++(this->generation));
+}
+
+/**
+ * Returns true if a request of the given generation has not been cancelled since.
+ * @param requestGeneration The generation of the request.
+ */
+bool GameWorker::isCurrent (int requestGeneration)
+{
+  return (requestGeneration == this->generation.load ());
+}
+
+/**
+ * Requests a set of presses that wins the game from its current state. The result is emitted by solutionReady. The return value is the generation of the request.
+ * @param game The game, whose state is copied before the call returns.
+ */
+int GameWorker::requestSolution (Blackout *game)
+{
+  int requestGeneration = this->generation.load ();
+
+  this->pool->start (new SolveTask (this, requestGeneration, false, game));
+  return (requestGeneration);
+}
+
+/**
+ * Requests the next cell to press to win the game from its current state. The result is emitted by hintReady. The return value is the generation of the request.
+ * @param game The game, whose state is copied before the call returns.
+ */
+int GameWorker::requestHint (Blackout *game)
+{
+  int requestGeneration = this->generation.load ();
+
+  this->pool->start (new SolveTask (this, requestGeneration, true, game));
+  return (requestGeneration);
+}
+
+/**
+ * Requests a new game, generated and rated. The result is emitted by gameReady. The return value is the generation of the request.
+ * @param size The side of the board.
+ */
+int GameWorker::requestGame (int size)
+{
+  int requestGeneration = this->generation.load ();
+
+  this->pool->start (new GenerateTask (this, requestGeneration, size));
+  return (requestGeneration);
+}
+
+/**
+ * Called by a solving task when it is done: emits solutionReady or hintReady if the request is still current.
+ * @param requestGeneration The generation of the request.
+ * @param hint If true, the request was for a hint.
+ * @param size The side of the board.
+ * @param solved If false, the state cannot be won.
+ * @param presses The presses found.
+ */
+void GameWorker::finishSolution (int requestGeneration, bool hint, int size, bool solved, const PressSet &presses)
+{
+  int x = 0, y = 0;
+
+  if (!this->isCurrent (requestGeneration))
+    {
+      return;
+    }
+
+  if (!hint)
+    {
+      emit this->solutionReady (requestGeneration, solved, solved ? presses : PressSet ());
+      return;
+    }
+
+  if (solved && !firstPress (size, presses, &x, &y))
+    {
+      // The board is already won
+      x = 0;
+      y = 0;
+    }
+  emit this->hintReady (requestGeneration, x, y, solved ? (qint64) popCountWords (presses.data (), presses.size ()) : -1);
+}
+
+/**
+ * Called by a generating task when it is done: emits gameReady if the request is still current, or frees the game.
+ * @param requestGeneration The generation of the request.
+ * @param game The game generated, or NULL if none could be.
+ * @param par The number of moves against which the game is rated.
+ */
+void GameWorker::finishGame (int requestGeneration, Blackout *game, int par)
+{
+  if (!this->isCurrent (requestGeneration))
+    {
+      delete (game);
+      return;
+    }
+  emit this->gameReady (requestGeneration, game, par);
+}
@@ -0,0 +1,139 @@
+/**
+ *@file gameWorker.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class GameWorker.
+ *@details The GameWorker class runs the solver and the generator of the GUI on a pool of threads.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GAMEWORKER_H
+#define GAMEWORKER_H
+
+#include <QObject>
+#include <QThreadPool>
+
+#include <atomic>
+#include <vector>
+
+#include "blackout.h"
+
+/**
+ * A set of presses, in the layout of Blackout::getPressWords.
+ */
+typedef std::vector<uint64_t> PressSet;
+
+/**
+ * The GameWorker class runs the work of the GUI that can take longer than a frame, solving, hinting and generating with rating, as tasks on a pool of threads, so that the event loop never waits for it. A task works on its own copy of the state of the board, taken when it is requested, and never on the game shown.
+ * Every request is tagged with the current generation. Cancelling, as the GUI does whenever the player moves, starts a new generation: the tasks of older generations are dropped before they start, their results are not emitted, and the results already queued are recognised as stale by isCurrent. The results are emitted from the pool threads and reach the GUI through queued connections.
+ */
+class GameWorker : public QObject
+{
+  Q_OBJECT
+
+ private:
+  /**
+   * The threads on which the tasks run.
+   */
+  QThreadPool *pool;
+  /**
+   * The current generation of requests.
+   */
+  std::atomic<int> generation;
+
+ public:
+    /**
+     * Constructor that creates the pool of threads, with one thread per core.
+     * @param parent The parent object.
+     */
+    explicit GameWorker (QObject *parent = 0);
+    /**
+     * Destructor that cancels the pending requests and waits for the running tasks to finish.
+     */
+    ~GameWorker ();
+    /**
+     * Cancels every pending request and returns the new generation.
+     */
+    int cancel ();
+    /**
+     * Returns true if a request of the given generation has not been cancelled since.
+     * @param requestGeneration The generation of the request.
+     */
+    bool isCurrent (int requestGeneration);
+    /**
+     * Requests a set of presses that wins the game from its current state. The result is emitted by solutionReady. The return value is the generation of the request.
+     * @param game The game, whose state is copied before the call returns.
+     */
+    int requestSolution (Blackout *game);
+    /**
+     * Requests the next cell to press to win the game from its current state. The result is emitted by hintReady. The return value is the generation of the request.
+     * @param game The game, whose state is copied before the call returns.
+     */
+    int requestHint (Blackout *game);
+    /**
+     * Requests a new game, generated and rated. The result is emitted by gameReady. The return value is the generation of the request.
+     * @param size The side of the board.
+     */
+    int requestGame (int size);
+    /**
+     * Called by a solving task when it is done: emits solutionReady or hintReady if the request is still current.
+     * @param requestGeneration The generation of the request.
+     * @param hint If true, the request was for a hint.
+     * @param size The side of the board.
+     * @param solved If false, the state cannot be won.
+     * @param presses The presses found.
+     */
+    void finishSolution (int requestGeneration, bool hint, int size, bool solved, const PressSet &presses);
+    /**
+     * Called by a generating task when it is done: emits gameReady if the request is still current, or frees the game.
+     * @param requestGeneration The generation of the request.
+     * @param game The game generated, or NULL if none could be.
+     * @param par The number of moves against which the game is rated.
+     */
+    void finishGame (int requestGeneration, Blackout *game, int par);
+
+ signals:
+    /**
+     * Emitted when a solution is found.
+     * @param requestGeneration The generation of the request.
+     * @param solved If false, the state cannot be won and presses is empty.
+     * @param presses The presses that win the game.
+     */
+    void solutionReady (int requestGeneration, bool solved, PressSet presses);
+    /**
+     * Emitted when a hint is found.
+     * @param requestGeneration The generation of the request.
+     * @param x Row number of the cell to press, or 0 if the game is already won or cannot be won.
+     * @param y Column number of the cell to press, or 0 if the game is already won or cannot be won.
+     * @param remaining Number of presses of the solution the hint is taken from, or -1 if the state cannot be won.
+     */
+    void hintReady (int requestGeneration, int x, int y, qint64 remaining);
+    /**
+     * Emitted when a new game is ready. The receiver takes ownership of the game.
+     * @param requestGeneration The generation of the request.
+     * @param game The game, or NULL if none could be generated.
+     * @param par The fewest moves that win the game for a packed board, the presses of the solution found for a large board, or -1 if it could not be solved.
+     */
+    void gameReady (int requestGeneration, Blackout *game, int par);
+};
+
+#endif
@@ -0,0 +1,271 @@
+/**
+ *@file instrumentation.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class Instrumentation.
+ *@details The Instrumentation class counts events on the hot paths of the game, measures how long operations take, and exports the measurements as a trace.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "instrumentation.h"
+
+/**
+ * A timed operation in the trace.
+ */
+struct TraceEvent
+{
+  /**
+   * The operation.
+   */
+  InstrumentOperation operation;
+  /**
+   * Number of the thread that made the operation.
+   */
+  uint32_t thread;
+  /**
+   * The time at which the operation started, in nanoseconds since the program started.
+   */
+  uint64_t start;
+  /**
+   * The time taken by the operation, in nanoseconds.
+   */
+  uint64_t duration;
+};
+
+std::atomic<bool> Instrumentation::enabled (false);
+
+/**
+ * The counters.
+ */
+static std::atomic<uint64_t> counters[N_INSTRUMENT_COUNTERS];
+
+/**
+ * The latency histograms of the operations.
+ */
+static std::atomic<uint64_t> histograms[N_INSTRUMENT_OPERATIONS][INSTRUMENT_HISTOGRAM_BUCKETS];
+
+/**
+ * The trace, and the mutex that guards it.
+ */
+static std::vector<TraceEvent> trace;
+static std::mutex traceMutex;
+
+/**
+ * The time at which the program started.
+ */
+static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now ();
+
+/**
+ * Number given to the next thread that records an operation.
+ */
+static std::atomic<uint32_t> nextThread (1);
+
+static const char *counterNames[N_INSTRUMENT_COUNTERS] =
+  {
+    "moves", "flips", "win checks", "generation retries", "save bytes", "load bytes"
+  };
+
+static const char *operationNames[N_INSTRUMENT_OPERATIONS] =
+  {
+    "Blackout::applyMove", "Blackout::applyPresses", "Blackout::flipCell", "Blackout::checkWinCondition", "Blackout::generateGame", "Blackout::solve", "save", "load", "game turn", "new game", "BoardWidget::paintEvent"
+  };
+
+/**
+ * Switches the instrumentation on or off. The measurements made so far are kept.
+ * @param on Whether the instrumentation is switched on.
+ */
+void Instrumentation::setEnabled (bool on)
+{
+  enabled.store (on);
+}
+
+/**
+ * Clears the counters, the histograms and the trace.
+ */
+void Instrumentation::clear ()
+{
+  int i, j;
+
+  for (i=0; i<N_INSTRUMENT_COUNTERS; i++)
+    {
+      counters[i].store (0);
+    }
+  for (i=0; i<N_INSTRUMENT_OPERATIONS; i++)
+    {
+      for (j=0; j<INSTRUMENT_HISTOGRAM_BUCKETS; j++)
+	{
+	  histograms[i][j].store (0);
+	}
+    }
+  std::lock_guard<std::mutex> lock (traceMutex);
+  trace.clear ();
+}
+
+/**
+ * Returns the time in nanoseconds since the program started.
+ */
+uint64_t Instrumentation::now ()
+{
+  return ((uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - startTime).count ());
+}
+
+/**
+ * Adds n to a counter.
+ * @param counter The counter.
+ * @param n The amount added.
+ */
+void Instrumentation::count (InstrumentCounter counter, uint64_t n)
+{
+  counters[counter].fetch_add (n, std::memory_order_relaxed);
+}
+
+/**
+ * Records an operation: it is added to the histogram of the operation and to the trace.
+ * @param operation The operation.
+ * @param start The time at which the operation started, as given by now().
+ * @param duration The time taken by the operation, in nanoseconds.
+ */
+void Instrumentation::record (InstrumentOperation operation, uint64_t start, uint64_t duration)
+{
+  static thread_local uint32_t thread = nextThread.fetch_add (1);
+  int bucket = 0;
+  uint64_t d = duration;
+  TraceEvent event;
+
+  // The bucket is the number of significant bits of the duration
+  while (d && bucket < INSTRUMENT_HISTOGRAM_BUCKETS-1)
+    {
+      bucket++;
+      d >>= 1;
+    }
+  histograms[operation][bucket].fetch_add (1, std::memory_order_relaxed);
+
+  event.operation = operation;
+  event.thread = thread;
+  event.start = start;
+  event.duration = duration;
+  std::lock_guard<std::mutex> lock (traceMutex);
+  if (trace.size () < INSTRUMENT_TRACE_CAPACITY)
+    {
+      trace.push_back (event);
+    }
+}
+
+/**
+ * Returns the value of a counter.
+ * @param counter The counter.
+ */
+uint64_t Instrumentation::getCounter (InstrumentCounter counter)
+{
+  return (counters[counter].load ());
+}
+
+/**
+ * Returns the number of operations counted in a bucket of the latency histogram of an operation.
+ * @param operation The operation.
+ * @param bucket The bucket, in [0, INSTRUMENT_HISTOGRAM_BUCKETS).
+ */
+uint64_t Instrumentation::getHistogram (InstrumentOperation operation, int bucket)
+{
+  return (histograms[operation][bucket].load ());
+}
+
+/**
+ * Returns the name of a counter.
+ * @param counter The counter.
+ */
+const char *Instrumentation::getCounterName (InstrumentCounter counter)
+{
+  return (counterNames[counter]);
+}
+
+/**
+ * Returns the name of an operation.
+ * @param operation The operation.
+ */
+const char *Instrumentation::getOperationName (InstrumentOperation operation)
+{
+  return (operationNames[operation]);
+}
+
+/**
+ * Writes the trace, the counters and the histograms to a file in the Chrome trace event format. The return value is false if the file cannot be written.
+ * @param fileName Name of the file.
+ */
+bool Instrumentation::exportTrace (const char *fileName)
+{
+  FILE *outFile = fopen (fileName, "w");
+  size_t i;
+  int c, op, b, last;
+  uint64_t endTime = Instrumentation::now ();
+
+  if (!outFile)
+    {
+      return (false);
+    }
+
+  // Times are in microseconds in the trace event format
+  fprintf (outFile, "{\"traceEvents\": [\n");
+  {
+    std::lock_guard<std::mutex> lock (traceMutex);
+    for (i=0; i<trace.size (); i++)
+      {
+	fprintf (outFile, "{\"name\": \"%s\", \"cat\": \"blackout\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f},\n",
+		 operationNames[trace[i].operation], trace[i].thread, trace[i].start / 1000.0, trace[i].duration / 1000.0);
+      }
+  }
+  fprintf (outFile, "{\"name\": \"counters\", \"cat\": \"blackout\", \"ph\": \"C\", \"pid\": 1, \"tid\": 0, \"ts\": %.3f, \"args\": {", endTime / 1000.0);
+  for (c=0; c<N_INSTRUMENT_COUNTERS; c++)
+    {
+      fprintf (outFile, "%s\"%s\": %" PRIu64, c ? ", " : "", counterNames[c], counters[c].load ());
+    }
+  fprintf (outFile, "}}\n],\n");
+
+  // Histograms: for each operation, the counts of the buckets up to the last one that is not empty
+  fprintf (outFile, "\"otherData\": {\"histogram_bucket\": \"bucket b counts durations in [2^(b-1), 2^b) ns\"");
+  for (op=0; op<N_INSTRUMENT_OPERATIONS; op++)
+    {
+      last = -1;
+      for (b=0; b<INSTRUMENT_HISTOGRAM_BUCKETS; b++)
+	{
+	  if (histograms[op][b].load ())
+	    {
+	      last = b;
+	    }
+	}
+      fprintf (outFile, ",\n\"%s\": \"", operationNames[op]);
+      for (b=0; b<=last; b++)
+	{
+	  fprintf (outFile, "%s%" PRIu64, b ? " " : "", histograms[op][b].load ());
+	}
+      fprintf (outFile, "\"");
+    }
+  fprintf (outFile, "}}\n");
+
+  return (fclose (outFile) == 0);
+}
@@ -0,0 +1,200 @@
+/**
+ *@file instrumentation.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class Instrumentation.
+ *@details The Instrumentation class counts events on the hot paths of the game, measures how long operations take, and exports the measurements as a trace.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * Largest number of trace events kept in memory. Later events are still counted and added to the histograms, but not traced.
+ */
+#ifndef INSTRUMENT_TRACE_CAPACITY
+#define INSTRUMENT_TRACE_CAPACITY 1000000
+#endif
+
+/**
+ * Number of buckets of the latency histograms. Bucket b counts the operations that took from 2^(b-1) to 2^b-1 nanoseconds, bucket 0 those that took 0 ns.
+ */
+#ifndef INSTRUMENT_HISTOGRAM_BUCKETS
+#define INSTRUMENT_HISTOGRAM_BUCKETS 48
+#endif
+
+/**
+ * The events counted.
+ */
+enum InstrumentCounter
+  {
+    COUNT_MOVES,
+    COUNT_FLIPS,
+    COUNT_WIN_CHECKS,
+    COUNT_GENERATION_RETRIES,
+    COUNT_SAVE_BYTES,
+    COUNT_LOAD_BYTES,
+    N_INSTRUMENT_COUNTERS
+  };
+
+/**
+ * The operations timed.
+ */
+enum InstrumentOperation
+  {
+    OP_APPLY_MOVE,
+    OP_APPLY_PRESSES,
+    OP_FLIP_CELL,
+    OP_WIN_CHECK,
+    OP_GENERATE,
+    OP_SOLVE,
+    OP_SAVE,
+    OP_LOAD,
+    OP_TURN,
+    OP_NEW_GAME,
+    OP_PAINT,
+    N_INSTRUMENT_OPERATIONS
+  };
+
+/**
+ * The Instrumentation class holds the counters, the latency histograms and the trace of the whole program. It is switched on and off at run time; while it is off, each instrumented point costs one relaxed load of a flag and a predictable branch.
+ * The trace is exported in the Chrome trace event format, which chrome://tracing and Perfetto display: every timed operation is a complete ("X") event, the counters are counter ("C") events, and the histograms are in "otherData".
+ */
+class Instrumentation
+{
+ private:
+  /**
+   * Whether the instrumentation is switched on.
+   */
+  static std::atomic<bool> enabled;
+
+ public:
+  /**
+   * Returns whether the instrumentation is switched on.
+   */
+  static bool isEnabled ()
+  {
+    return (enabled.load (std::memory_order_relaxed));
+  }
+  /**
+   * Switches the instrumentation on or off. The measurements made so far are kept.
+   * @param on Whether the instrumentation is switched on.
+   */
+  static void setEnabled (bool on);
+  /**
+   * Clears the counters, the histograms and the trace.
+   */
+  static void clear ();
+  /**
+   * Returns the time in nanoseconds since the program started.
+   */
+  static uint64_t now ();
+  /**
+   * Adds n to a counter.
+   * @param counter The counter.
+   * @param n The amount added.
+   */
+  static void count (InstrumentCounter counter, uint64_t n);
+  /**
+   * Records an operation: it is added to the histogram of the operation and to the trace.
+   * @param operation The operation.
+   * @param start The time at which the operation started, as given by now().
+   * @param duration The time taken by the operation, in nanoseconds.
+   */
+  static void record (InstrumentOperation operation, uint64_t start, uint64_t duration);
+  /**
+   * Returns the value of a counter.
+   * @param counter The counter.
+   */
+  static uint64_t getCounter (InstrumentCounter counter);
+  /**
+   * Returns the number of operations counted in a bucket of the latency histogram of an operation.
+   * @param operation The operation.
+   * @param bucket The bucket, in [0, INSTRUMENT_HISTOGRAM_BUCKETS).
+   */
+  static uint64_t getHistogram (InstrumentOperation operation, int bucket);
+  /**
+   * Returns the name of a counter.
+   * @param counter The counter.
+   */
+  static const char *getCounterName (InstrumentCounter counter);
+  /**
+   * Returns the name of an operation.
+   * @param operation The operation.
+   */
+  static const char *getOperationName (InstrumentOperation operation);
+  /**
+   * Writes the trace, the counters and the histograms to a file in the Chrome trace event format. The return value is false if the file cannot be written.
+   * @param fileName Name of the file.
+   */
+  static bool exportTrace (const char *fileName);
+};
+
+/**
+ * Adds n to counter if the instrumentation is switched on.
+ */
+#define INSTRUMENT_COUNT(counter, n) \
+  do { if (Instrumentation::isEnabled ()) { Instrumentation::count ((counter), (n)); } } while (0)
+
+/**
+ * The ScopedTimer class times the block in which it is declared, if the instrumentation is switched on when the block is entered.
+ */
+class ScopedTimer
+{
+ private:
+  /**
+   * The operation timed.
+   */
+  InstrumentOperation operation;
+  /**
+   * The time at which the block was entered, or 0 if it is not timed.
+   */
+  uint64_t start;
+
+ public:
+  /**
+   * Constructor that starts timing the operation.
+   * @param op The operation timed.
+   */
+  ScopedTimer (InstrumentOperation op)
+  {
+    this->operation = op;
+    this->start = Instrumentation::isEnabled () ? Instrumentation::now () + 1 : 0;
+  }
+  /**
+   * Destructor that records the operation.
+   */
+  ~ScopedTimer ()
+  {
+    if (this->start)
+      {
+	uint64_t end = Instrumentation::now () + 1;
+	Instrumentation::record (this->operation, this->start - 1, end - this->start);
+      }
+  }
+};
+
+#endif
@@ -0,0 +1,280 @@
+/**
+ *@file largeSolver.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class LargeSolver.
+ *@details The LargeSolver class finds the moves that solve a state of a large board.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "largeSolver.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+/**
+ * Constructor that builds and reduces the matrix M for the given side.
+ * @param sideLength The side of the square board.
+ */
+LargeSolver::LargeSolver (int sideLength)
+{
+  int n, w, i, j, k, r, c;
+
+  this->boardSize = sideLength;
+  this->rowWords = (sideLength + 63) / 64;
+  this->lastWordMask = (sideLength % 64) ? ((((uint64_t) 1) << (sideLength % 64)) - 1) : ~((uint64_t) 0);
+  n = this->boardSize;
+  w = this->rowWords;
+
+  // The presses of a row, as a function of f: for every column, the vector of the first row presses that press it.
+  std::vector<uint64_t> previous (n*w, 0);
+  std::vector<uint64_t> current (n*w, 0);
+  std::vector<uint64_t> next (n*w, 0);
+  std::vector<uint64_t> zero (w, 0);
+
+  for (j=0; j<n; j++)
+    {
+      current[j*w + j/64] = ((uint64_t) 1) << (j % 64);
+    }
+
+  // The presses of the row below are the lights left in this row: the state, and the presses of the row above, of this row and of its neighbours in this row. The state only adds the constant c, so it is left out.
+  for (r=0; r<n; r++)
+    {
+      for (j=0; j<n; j++)
+	{
+	  const uint64_t *above = &previous[j*w];
+	  const uint64_t *cell = &current[j*w];
+	  const uint64_t *left = (j > 0) ? &current[(j-1)*w] : zero.data ();
+	  const uint64_t *right = (j < n-1) ? &current[(j+1)*w] : zero.data ();
+	  uint64_t *below = &next[j*w];
+
+	  for (k=0; k<w; k++)
+	    {
+	      below[k] = above[k] ^ cell[k] ^ left[k] ^ right[k];
+	    }
+	}
+      previous.swap (current);
+      current.swap (next);
+    }
+
+  // current holds the lights left below the bottom row: row j of M is the vector of current for column j. Reduce [M | I] to reduced row echelon form.
+  std::vector<uint64_t> augmented (n*2*w, 0);
+
+  for (i=0; i<n; i++)
+    {
+      for (k=0; k<w; k++)
+	{
+	  augmented[i*2*w + k] = current[i*w + k];
+	}
+      augmented[i*2*w + w + i/64] = ((uint64_t) 1) << (i % 64);
+    }
+
+  this->rank = 0;
+  for (c=0; c<n && this->rank<n; c++)
+    {
+      // Find a pivot for column c
+      for (i=this->rank; i<n; i++)
+	{
+	  if ((augmented[i*2*w + c/64] >> (c % 64)) & 1)
+	    {
+	      break;
+	    }
+	}
+      if (i == n)
+	{
+	  // Free column
+	  continue;
+	}
+
+      // Move the pivot row into place
+      uint64_t *pivot = &augmented[this->rank*2*w];
+      if (i != this->rank)
+	{
+	  for (k=0; k<2*w; k++)
+	    {
+	      std::swap (augmented[i*2*w + k], pivot[k]);
+	    }
+	}
+
+      // Clear column c from every other row
+      for (r=0; r<n; r++)
+	{
+	  uint64_t *row = &augmented[r*2*w];
+	  if (r != this->rank && ((row[c/64] >> (c % 64)) & 1))
+	    {
+	      for (k=0; k<2*w; k++)
+		{
+		  row[k] ^= pivot[k];
+		}
+	    }
+	}
+
+      this->pivotColumn.push_back (c);
+      (this->rank)++;
+    }
+
+  // Only the row operations are needed to solve
+  this->reduction.resize (n*w);
+  for (i=0; i<n; i++)
+    {
+      for (k=0; k<w; k++)
+	{
+	  this->reduction[i*w + k] = augmented[i*2*w + w + k];
+	}
+    }
+}
+
+/**
+ * Returns the shared solver of the given board size, or NULL if the size is not within [MAX_BOARDSIZE+1, LARGE_SOLVER_MAX_SIZE]. The solver of a size is built on the first call for that size, which may be long for the largest sizes, and reused by every game. The call is thread-safe.
+ * @param sideLength The side of the square board.
+ */
+LargeSolver *LargeSolver::forSize (int sideLength)
+{
+  static std::mutex lock;
+  static std::map<int, LargeSolver *> solvers;
+
+  if (sideLength <= MAX_BOARDSIZE || sideLength > LARGE_SOLVER_MAX_SIZE)
+    {
+      return (NULL);
+    }
+
+  std::lock_guard<std::mutex> guard (lock);
+  std::map<int, LargeSolver *>::iterator found = solvers.find (sideLength);
+  if (found != solvers.end ())
+    {
+      return (found->second);
+    }
+
+  LargeSolver *solver = new LargeSolver (sideLength);
+  solvers[sideLength] = solver;
+  return (solver);
+}
+
+/**
+ * Chases the lights of state down the board from the first row presses already in presses. The presses of every other row are written to presses, and the lights left in the bottom row to residue.
+ * @param state The state of the board.
+ * @param allOn If true, the lights chased are the unlit cells, so that the presses switch every cell on.
+ * @param presses The press set, whose first row holds the presses of the first row.
+ * @param residue Pointer to the rowWords words where the lights left in the bottom row are copied.
+ */
+void LargeSolver::chase (const uint64_t *state, bool allOn, uint64_t *presses, uint64_t *residue)
+{
+  int n = this->boardSize;
+  int w = this->rowWords;
+  int r, k;
+  const uint64_t *above = NULL;
+  uint64_t lights;
+
+  for (r=0; r<n; r++)
+    {
+      const uint64_t *row = state + (size_t) r*w;
+      const uint64_t *current = presses + (size_t) r*w;
+      uint64_t *below = (r < n-1) ? presses + (size_t) (r+1)*w : residue;
+
+      // A press flips its cell and the cells on either side, across the words of the row
+      for (k=0; k<w; k++)
+	{
+	  lights = row[k] ^ current[k] ^ (current[k] << 1) ^ (current[k] >> 1);
+	  if (k > 0)
+	    {
+	      lights ^= current[k-1] >> 63;
+	    }
+	  if (k < w-1)
+	    {
+	      lights ^= current[k+1] << 63;
+	    }
+	  if (above)
+	    {
+	      lights ^= above[k];
+	    }
+	  below[k] = allOn ? ~lights : lights;
+	}
+      below[w-1] &= this->lastWordMask;
+      above = current;
+    }
+}
+
+/**
+ * Finds a set of presses that switches every cell of the given state off, or on. The return value is false if the state cannot be solved. The call only reads the solver, so several threads may solve at once.
+ * @param state The state of the board to be solved.
+ * @param presses Pointer to the location where the set of presses is copied, of boardSize*rowWords words.
+ * @param allOn If true, the presses switch every cell on instead of off. Default value: false.
+ */
+bool LargeSolver::solve (const uint64_t *state, uint64_t *presses, bool allOn)
+{
+  int n = this->boardSize;
+  int w = this->rowWords;
+  int i, k, parity;
+  std::vector<uint64_t> residue (w);
+
+  // Chase with no first row presses to find the residue c
+  for (k=0; k<w; k++)
+    {
+      presses[k] = 0;
+    }
+  this->chase (state, allOn, presses, residue.data ());
+
+  // f = T c, provided the rows of T c without a pivot are 0
+  for (k=0; k<w; k++)
+    {
+      presses[k] = 0;
+    }
+  for (i=0; i<n; i++)
+    {
+      const uint64_t *t = &this->reduction[(size_t) i*w];
+      parity = 0;
+      for (k=0; k<w; k++)
+	{
+	  parity ^= popCount (t[k] & residue[k]);
+	}
+      if (!(parity & 1))
+	{
+	  continue;
+	}
+      if (i >= this->rank)
+	{
+	  return (false);
+	}
+      presses[this->pivotColumn[i] / 64] |= ((uint64_t) 1) << (this->pivotColumn[i] % 64);
+    }
+
+  // Chasing again with f clears the bottom row as well
+  this->chase (state, allOn, presses, residue.data ());
+  return (true);
+}
+
+/**
+ * Returns the number of 64-bit words of a state or of a set of presses.
+ */
+size_t LargeSolver::getStateWords ()
+{
+  return ((size_t) this->boardSize * this->rowWords);
+}
+
+/**
+ * Returns the rank of the first row matrix M. A state of the board can be solved only if its residue lies in the image of M.
+ */
+int LargeSolver::getRank ()
+{
+  return (this->rank);
+}
@@ -0,0 +1,115 @@
+/**
+ *@file largeSolver.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class LargeSolver.
+ *@details The LargeSolver class finds the moves that solve a state of a large board.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LARGESOLVER_H
+#define LARGESOLVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "tools.h"
+#include "board.h"
+
+/**
+ * The largest board side for which a LargeSolver can be built. Building one takes time in the cube of the side and memory in its square: about 50 ms and 0.5 MB for a side of 1024.
+ */
+#ifndef LARGE_SOLVER_MAX_SIZE
+#define LARGE_SOLVER_MAX_SIZE 4096
+#endif
+
+/**
+ * The LargeSolver class solves large boards, of side from MAX_BOARDSIZE+1 to LARGE_SOLVER_MAX_SIZE, by light chasing. Once the presses f of the first row are chosen, the lit cells of each row fix the presses of the row below, so the lights left in the bottom row are a linear function of f plus a residue that depends on the state: M f + c. The N x N matrix M over GF(2) depends only on the side N. It is computed and reduced once per side, keeping the row operations T that reduce it, so that solving a state is a chase to find c, f = T c, and a second chase with f.
+ * States and press sets use the layout of a large Board: the row x is held in rowWords words from (x-1)*rowWords, the cell (x, y) in the bit (y-1)%64 of the word (y-1)/64 of its row, and the bits past the end of a row are 0.
+ */
+class LargeSolver
+{
+ private:
+  /**
+   * The length of the side of the square board.
+   */
+  int boardSize;
+  /**
+   * Number of 64-bit words in a row, (boardSize+63)/64.
+   */
+  int rowWords;
+  /**
+   * Mask of the bits of the last word of a row that are inside the board.
+   */
+  uint64_t lastWordMask;
+  /**
+   * The row operations that reduce M to reduced row echelon form, one row of rowWords words per row of M.
+   */
+  std::vector<uint64_t> reduction;
+  /**
+   * The column of the pivot of each of the first rank rows of the reduced matrix.
+   */
+  std::vector<int> pivotColumn;
+  /**
+   * The rank of M. The first row presses are unique up to the boardSize-rank free columns, which are left unpressed.
+   */
+  int rank;
+
+  /**
+   * Constructor that builds and reduces the matrix M for the given side.
+   * @param sideLength The side of the square board.
+   */
+  LargeSolver (int sideLength);
+  /**
+   * Chases the lights of state down the board from the first row presses already in presses. The presses of every other row are written to presses, and the lights left in the bottom row to residue.
+   * @param state The state of the board.
+   * @param allOn If true, the lights chased are the unlit cells, so that the presses switch every cell on.
+   * @param presses The press set, whose first row holds the presses of the first row.
+   * @param residue Pointer to the rowWords words where the lights left in the bottom row are copied.
+   */
+  void chase (const uint64_t *state, bool allOn, uint64_t *presses, uint64_t *residue);
+
+ public:
+  /**
+   * Returns the shared solver of the given board size, or NULL if the size is not within [MAX_BOARDSIZE+1, LARGE_SOLVER_MAX_SIZE]. The solver of a size is built on the first call for that size, which may be long for the largest sizes, and reused by every game. The call is thread-safe.
+   * @param sideLength The side of the square board.
+   */
+  static LargeSolver *forSize (int sideLength);
+  /**
+   * Finds a set of presses that switches every cell of the given state off, or on. The return value is false if the state cannot be solved. The call only reads the solver, so several threads may solve at once.
+   * @param state The state of the board to be solved.
+   * @param presses Pointer to the location where the set of presses is copied, of boardSize*rowWords words.
+   * @param allOn If true, the presses switch every cell on instead of off. Default value: false.
+   */
+  bool solve (const uint64_t *state, uint64_t *presses, bool allOn=false);
+  /**
+   * Returns the number of 64-bit words of a state or of a set of presses.
+   */
+  size_t getStateWords ();
+  /**
+   * Returns the rank of the first row matrix M. A state of the board can be solved only if its residue lies in the image of M.
+   */
+  int getRank ();
+};
+
+#endif
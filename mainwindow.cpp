@@ -22,14 +22,209 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 
+#include <QInputDialog>
+#include <QMenu>
+#include <QAction>
+#include <QKeySequence>
+#include <QStatusBar>
+
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
-    ui(new Ui::MainWindow)
+    ui(new Ui::MainWindow),
+    game(NULL),
+    par(-1),
+    generating(false)
 {
     ui->setupUi(this);
+    ui->mainToolBar->hide();
+
+    board = new BoardWidget(this);
+    setCentralWidget(board);
+    connect(board, SIGNAL(moved(int,int)), this, SLOT(playerMoved()));
+    connect(board, SIGNAL(won()), this, SLOT(gameWon()));
+
+    // Solving and generating run on the worker's threads; the results come back as queued signals.
+    worker = new GameWorker(this);
+    connect(worker, SIGNAL(hintReady(int,int,int,qint64)), this, SLOT(showHint(int,int,int,qint64)));
+    connect(worker, SIGNAL(solutionReady(int,bool,PressSet)), this, SLOT(showSolution(int,bool,PressSet)));
+    connect(worker, SIGNAL(gameReady(int,Blackout*,int)), this, SLOT(showGame(int,Blackout*,int)));
+
+    QMenu *gameMenu = ui->menuBar->addMenu(tr("&Game"));
+    gameMenu->addAction(tr("&New..."), this, SLOT(newGame()), QKeySequence::New);
+    gameMenu->addAction(tr("&Undo"), this, SLOT(undoMove()), QKeySequence::Undo);
+    gameMenu->addAction(tr("&Redo"), this, SLOT(redoMove()), QKeySequence::Redo);
+    gameMenu->addAction(tr("Rese&t"), this, SLOT(resetGame()));
+    gameMenu->addSeparator();
+    gameMenu->addAction(tr("&Hint"), this, SLOT(requestHint()), QKeySequence(tr("H")));
+    gameMenu->addAction(tr("&Solve"), this, SLOT(requestSolution()));
+    gameMenu->addSeparator();
+    gameMenu->addAction(tr("Zoom &in"), board, SLOT(zoomIn()), QKeySequence::ZoomIn);
+    gameMenu->addAction(tr("Zoom &out"), board, SLOT(zoomOut()), QKeySequence::ZoomOut);
+    gameMenu->addAction(tr("&Fit board"), board, SLOT(fitBoard()));
+    gameMenu->addSeparator();
+    gameMenu->addAction(tr("&Quit"), this, SLOT(close()), QKeySequence::Quit);
+
+    statusLabel = new QLabel(this);
+    ui->statusBar->addWidget(statusLabel);
+
+    setWindowTitle(tr("Blackout"));
+    resize(640, 640);
+    startGame(DEFAULT_GAMESQUARESIZE);
 }
 
 MainWindow::~MainWindow()
 {
+    // Wait for the running tasks before the game goes away.
+    delete worker;
+    delete game;
     delete ui;
 }
+
+void MainWindow::startGame(int size)
+{
+    // Moves on the old game would cancel the request, so the board is disabled until the new game arrives.
+    generating = true;
+    board->setEnabled(false);
+    worker->cancel();
+    worker->requestGame(size);
+    statusBar()->showMessage(tr("Generating a %1x%1 game...").arg(size));
+}
+
+void MainWindow::showGame(int requestGeneration, Blackout *newGame, int newPar)
+{
+    if (!worker->isCurrent(requestGeneration)) {
+        delete newGame;
+        return;
+    }
+
+    generating = false;
+    board->setEnabled(true);
+    if (!newGame) {
+        statusBar()->showMessage(tr("Could not generate a game."), 5000);
+        return;
+    }
+
+    // The widget must stop using the old game before it is freed.
+    board->setGame(newGame);
+    delete game;
+    game = newGame;
+    par = newPar;
+    updateStatus();
+}
+
+void MainWindow::newGame()
+{
+    bool ok;
+    // Larger boards could be played, but have no solver for hints and solutions.
+    int size = QInputDialog::getInt(this, tr("New game"), tr("Board size:"),
+                                    game ? game->getSize() : DEFAULT_GAMESQUARESIZE,
+                                    1, LARGE_SOLVER_MAX_SIZE, 1, &ok);
+    if (ok)
+        startGame(size);
+}
+
+void MainWindow::stateChanged()
+{
+    // Hints and solutions asked for before the change no longer apply.
+    worker->cancel();
+    board->setHint(0, 0);
+    updateStatus();
+}
+
+void MainWindow::playerMoved()
+{
+    stateChanged();
+}
+
+void MainWindow::undoMove()
+{
+    int x, y;
+    if (game && !generating && game->undo(&x, &y)) {
+        board->refreshMove(x, y);
+        stateChanged();
+    }
+}
+
+void MainWindow::redoMove()
+{
+    int x, y;
+    if (game && !generating && game->redo(&x, &y)) {
+        board->refreshMove(x, y);
+        stateChanged();
+    }
+}
+
+void MainWindow::resetGame()
+{
+    if (game && !generating) {
+        game->reset();
+        board->refresh();
+        stateChanged();
+    }
+}
+
+void MainWindow::requestHint()
+{
+    if (!game || generating)
+        return;
+    worker->requestHint(game);
+    statusBar()->showMessage(tr("Looking for a hint..."));
+}
+
+void MainWindow::requestSolution()
+{
+    if (!game || generating)
+        return;
+    worker->requestSolution(game);
+    statusBar()->showMessage(tr("Solving..."));
+}
+
+void MainWindow::showHint(int requestGeneration, int x, int y, qint64 remaining)
+{
+    // A result queued before the player moved again is stale.
+    if (!worker->isCurrent(requestGeneration))
+        return;
+
+    if (remaining < 0)
+        statusBar()->showMessage(tr("This board cannot be won."), 5000);
+    else if (x == 0)
+        statusBar()->showMessage(tr("The board is already won."), 5000);
+    else {
+        board->setHint(x, y);
+        statusBar()->showMessage(tr("Press row %1, column %2: %3 moves to go.").arg(x).arg(y).arg(remaining));
+    }
+}
+
+void MainWindow::showSolution(int requestGeneration, bool solved, PressSet presses)
+{
+    if (!worker->isCurrent(requestGeneration))
+        return;
+
+    if (!solved) {
+        statusBar()->showMessage(tr("This board cannot be won."), 5000);
+        return;
+    }
+
+    game->applyPresses(presses.data());
+    board->refresh();
+    stateChanged();
+    if (game->checkWinCondition())
+        gameWon();
+}
+
+void MainWindow::updateStatus()
+{
+    if (!game)
+        return;
+    statusBar()->clearMessage();
+    if (par >= 0)
+        statusLabel->setText(tr("%1x%1 board, %2 moves, par %3").arg(game->getSize()).arg(game->getMoves()).arg(par));
+    else
+        statusLabel->setText(tr("%1x%1 board, %2 moves").arg(game->getSize()).arg(game->getMoves()));
+}
+
+void MainWindow::gameWon()
+{
+    updateStatus();
+    statusBar()->showMessage(tr("You win, in %1 moves!").arg(game->getMoves()));
+}
@@ -23,6 +23,11 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QLabel>
+
+#include "blackout.h"
+#include "boardWidget.h"
+#include "gameWorker.h"
 
 namespace Ui {
 class MainWindow;
@@ -36,8 +41,31 @@ public:
     explicit MainWindow(QWidget *parent = 0);
     ~MainWindow();
     
+private slots:
+    void newGame();
+    void undoMove();
+    void redoMove();
+    void resetGame();
+    void requestHint();
+    void requestSolution();
+    void playerMoved();
+    void showHint(int requestGeneration, int x, int y, qint64 remaining);
+    void showSolution(int requestGeneration, bool solved, PressSet presses);
+    void showGame(int requestGeneration, Blackout *newGame, int newPar);
+    void updateStatus();
+    void gameWon();
+
 private:
+    void startGame(int size);
+    void stateChanged();
+
     Ui::MainWindow *ui;
+    Blackout *game;
+    int par;
+    bool generating;
+    BoardWidget *board;
+    GameWorker *worker;
+    QLabel *statusLabel;
 };
 
 #endif // MAINWINDOW_H
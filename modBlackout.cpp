@@ -0,0 +1,259 @@
+/**
+ *@file modBlackout.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class ModBlackout.
+ *@details The ModBlackout class plays the multi-state variant of the game, whose cells take k values.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "modBlackout.h"
+
+/**
+ * Constructor that initializes the game.
+ * @param boardSize The side of the board, at most MAX_BOARDSIZE. Default value: DEFAULT_GAMESQUARESIZE.
+ * @param states The number of states of a cell, k. Default value: DEFAULT_MOD_STATES.
+ * @param rule The cells changed by a move. Default value: the plus rule.
+ */
+ModBlackout::ModBlackout (int boardSize, int states, const Neighbourhood &rule)
+{
+  // Initialize the board. It starts with all cells set to 0.
+  this->b = new ModBoard (boardSize, states, rule);
+  this->nPoints = this->b->getSize ();
+  this->solver = ModSolver::forRule (this->nPoints, this->b->getStates (), rule);
+  this->nMoves = 0;
+  this->win = false;
+  this->solutionKnown = false;
+  this->movesRemaining = -1;
+}
+
+/**
+ * Destructor that frees the board.
+ */
+ModBlackout::~ModBlackout ()
+{
+  this->solver = NULL;
+  delete (this->b);
+  this->b = NULL;
+}
+
+/**
+ * This function generates a new game. Every cell is pressed a random number of times in [0, k), each count equally likely, starting from the empty board, so the game is drawn uniformly from the solvable states. A state that is already won is drawn again, up to maxAttempts times in all.
+ * @param maxAttempts Number of states drawn before giving up. Default value: GAME_GENERATION_ATTEMPTS.
+ */
+bool ModBlackout::generateGame (int maxAttempts)
+{
+  unsigned char presses[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  int attempt, i, nCells = this->nPoints * this->nPoints;
+
+  for (attempt=0; attempt<maxAttempts; attempt++)
+    {
+      for (i=0; i<nCells; i++)
+	{
+	  presses[i] = (unsigned char) getRandomInteger (0, this->b->getStates () - 1);
+	}
+      this->b->clear ();
+      this->b->pressCells (presses);
+
+      if (!this->checkWinCondition ())
+	{
+	  this->b->setInitialState ();
+	  this->nMoves = 0;
+	  this->solutionKnown = false;
+	  return (true);
+	}
+    }
+
+  // This is not working. Game generation failed
+  return (false);
+}
+
+/**
+ * Checks for the win condition, that every cell is 0. The cells are tested a whole word of lanes at a time.
+ */
+bool ModBlackout::checkWinCondition ()
+{
+  this->win = this->b->isClear ();
+  return (this->win);
+}
+
+/**
+ * Carries out the move at the position given by x and y. The return value is false if the co-ordinates are not valid.
+ * @param x Row number of the point where the move is carried out.
+ * @param y Column number of the point where the move is carried out.
+ */
+bool ModBlackout::applyMove (int x, int y)
+{
+  // Every cell of the neighbourhood is advanced by one addition per word of lanes
+  if (!this->b->pressCell (x, y))
+    {
+      return (false);
+    }
+
+  this->notePress (x, y);
+  (this->nMoves)++;
+  return (true);
+}
+
+/**
+ * Resets the game to its initial state and clears the move count.
+ */
+void ModBlackout::reset ()
+{
+  this->b->resetBoard ();
+  this->nMoves = 0;
+  this->solutionKnown = false;
+}
+
+/**
+ * Finds the number of times to press every cell to win the game from the current state. The return value is false if the state cannot be solved.
+ * @param presses The location where the number of presses of every cell, in the order of the cell index (x-1)*nPoints + (y-1), is copied.
+ */
+bool ModBlackout::solve (unsigned char *presses)
+{
+  unsigned char state[MAX_BOARDSIZE*MAX_BOARDSIZE];
+
+  if (!this->solver)
+    {
+      return (false);
+    }
+  this->b->getValues (state);
+  return (this->solver->solve (state, presses));
+}
+
+/**
+ * Finds the next cell to press to win the game, the first cell in reading order of a solution of the current state. The solution is kept up to date by every move, so it is only searched after a new game or a reset. The return value is false if the game is won, or its state cannot be solved.
+ * @param x Pointer to the location where the row number of the cell is copied.
+ * @param y Pointer to the location where the column number of the cell is copied.
+ */
+bool ModBlackout::getHint (int *x, int *y)
+{
+  int index;
+
+  this->findSolution ();
+  if (this->movesRemaining <= 0)
+    {
+      return (false);
+    }
+
+  for (index=0; this->solution[index]==0; index++)
+    ;
+  *x = index / this->nPoints + 1;
+  *y = index % this->nPoints + 1;
+  return (true);
+}
+
+/**
+ * Returns the number of presses of the known solution of the current state, or -1 if the state cannot be solved.
+ */
+int64_t ModBlackout::getMovesRemaining ()
+{
+  this->findSolution ();
+  return (this->movesRemaining);
+}
+
+/**
+ * Solves the current state into solution, unless solutionKnown is set.
+ */
+void ModBlackout::findSolution ()
+{
+  int i;
+
+  if (this->solutionKnown)
+    {
+      return;
+    }
+
+  this->movesRemaining = -1;
+  if (this->solve (this->solution))
+    {
+      this->movesRemaining = 0;
+      for (i=0; i<this->nPoints*this->nPoints; i++)
+	{
+	  this->movesRemaining += this->solution[i];
+	}
+    }
+  this->solutionKnown = true;
+}
+
+/**
+ * Takes one press of the cell (x, y) from the known solution, after a press of that cell.
+ * @param x Row number of the cell pressed.
+ * @param y Column number of the cell pressed.
+ */
+void ModBlackout::notePress (int x, int y)
+{
+  int index = (x-1) * this->nPoints + (y-1);
+
+  // An unsolvable state stays unsolvable whatever is pressed
+  if (!this->solutionKnown || this->movesRemaining < 0)
+    {
+      return;
+    }
+
+  // A count of 0 wraps around to k-1: the press is undone by k-1 more
+  if (this->solution[index] == 0)
+    {
+      this->solution[index] = (unsigned char) (this->b->getStates () - 1);
+      this->movesRemaining += this->b->getStates () - 1;
+    }
+  else
+    {
+      (this->solution[index])--;
+      (this->movesRemaining)--;
+    }
+}
+
+/**
+ * Returns in the pointer value the value of the cell at (x, y). If the co-ordinates are valid, the return is true, else false.
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ * @param value Pointer to the location in memory where the value of the cell is copied.
+ */
+bool ModBlackout::getCellValue (int x, int y, int *value)
+{
+  return (this->b->getCellValue (x, y, value));
+}
+
+/**
+ * Returns the length of the side of the board.
+ */
+int ModBlackout::getSize ()
+{
+  return (this->nPoints);
+}
+
+/**
+ * Returns the number of states of a cell.
+ */
+int ModBlackout::getStates ()
+{
+  return (this->b->getStates ());
+}
+
+/**
+ * Returns the number of moves made since the game started.
+ */
+int ModBlackout::getMoves ()
+{
+  return (this->nMoves);
+}
@@ -0,0 +1,157 @@
+/**
+ *@file modBlackout.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class ModBlackout.
+ *@details The ModBlackout class plays the multi-state variant of the game, whose cells take k values.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MODBLACKOUT_H
+#define MODBLACKOUT_H
+
+#include <stdint.h>
+
+#include "tools.h"
+#include "blackout.h"
+#include "neighbourhood.h"
+#include "modBoard.h"
+#include "modSolver.h"
+
+/**
+ * The ModBlackout class plays the multi-state variant of the game: every cell holds a value in [0, k), a move adds 1 modulo k to every cell of the neighbourhood of the pressed cell, and the game is won when every cell is back to 0. With k = 2 this is the game of the Blackout class, won on the dark board.
+ */
+class ModBlackout
+{
+ private:
+  /**
+   * The board on which the game is played.
+   */
+  ModBoard *b;
+  /**
+   * Solver for the board of this game. It is shared by all games with the same board size, number of states and rule.
+   */
+  ModSolver *solver;
+  /**
+   * Keeps count of the number of moves.
+   */
+  int nMoves;
+  /**
+   * Dimensions of the board.
+   */
+  int nPoints;
+  /**
+   * Set when the game is won.
+   */
+  bool win;
+  /**
+   * The number of times to press every cell to win the game from the current state. A move at a cell takes one from the count of that cell, modulo k. It is valid only while solutionKnown is set.
+   */
+  unsigned char solution[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  /**
+   * Set while solution and movesRemaining hold for the current state. It is cleared by a new game and by a reset.
+   */
+  bool solutionKnown;
+  /**
+   * Total of the counts of solution, or -1 if the current state cannot be solved.
+   */
+  int64_t movesRemaining;
+
+  /**
+   * Solves the current state into solution, unless solutionKnown is set.
+   */
+  void findSolution ();
+  /**
+   * Takes one press of the cell (x, y) from the known solution, after a press of that cell.
+   * @param x Row number of the cell pressed.
+   * @param y Column number of the cell pressed.
+   */
+  void notePress (int x, int y);
+
+ public:
+    /**
+     * Constructor that initializes the game.
+     * @param boardSize The side of the board, at most MAX_BOARDSIZE. Default value: DEFAULT_GAMESQUARESIZE.
+     * @param states The number of states of a cell, k. Default value: DEFAULT_MOD_STATES.
+     * @param rule The cells changed by a move. Default value: the plus rule.
+     */
+    ModBlackout (int boardSize=DEFAULT_GAMESQUARESIZE, int states=DEFAULT_MOD_STATES, const Neighbourhood &rule=Neighbourhood ());
+    /**
+     * Destructor that frees the board.
+     */
+    ~ModBlackout ();
+    /**
+     * This function generates a new game. Every cell is pressed a random number of times in [0, k), each count equally likely, starting from the empty board, so the game is drawn uniformly from the solvable states. A state that is already won is drawn again, up to maxAttempts times in all.
+     * @param maxAttempts Number of states drawn before giving up. Default value: GAME_GENERATION_ATTEMPTS.
+     */
+    bool generateGame (int maxAttempts=GAME_GENERATION_ATTEMPTS);
+    /**
+     * Checks for the win condition, that every cell is 0. The cells are tested a whole word of lanes at a time.
+     */
+    bool checkWinCondition ();
+    /**
+     * Carries out the move at the position given by x and y. The return value is false if the co-ordinates are not valid.
+     * @param x Row number of the point where the move is carried out.
+     * @param y Column number of the point where the move is carried out.
+     */
+    bool applyMove (int x, int y);
+    /**
+     * Resets the game to its initial state and clears the move count.
+     */
+    void reset ();
+    /**
+     * Finds the number of times to press every cell to win the game from the current state. The return value is false if the state cannot be solved.
+     * @param presses The location where the number of presses of every cell, in the order of the cell index (x-1)*nPoints + (y-1), is copied.
+     */
+    bool solve (unsigned char *presses);
+    /**
+     * Finds the next cell to press to win the game, the first cell in reading order of a solution of the current state. The solution is kept up to date by every move, so it is only searched after a new game or a reset. The return value is false if the game is won, or its state cannot be solved.
+     * @param x Pointer to the location where the row number of the cell is copied.
+     * @param y Pointer to the location where the column number of the cell is copied.
+     */
+    bool getHint (int *x, int *y);
+    /**
+     * Returns the number of presses of the known solution of the current state, or -1 if the state cannot be solved.
+     */
+    int64_t getMovesRemaining ();
+    /**
+     * Returns in the pointer value the value of the cell at (x, y). If the co-ordinates are valid, the return is true, else false.
+     * @param x Row number of the cell.
+     * @param y Column number of the cell.
+     * @param value Pointer to the location in memory where the value of the cell is copied.
+     */
+    bool getCellValue (int x, int y, int *value);
+    /**
+     * Returns the length of the side of the board.
+     */
+    int getSize ();
+    /**
+     * Returns the number of states of a cell.
+     */
+    int getStates ();
+    /**
+     * Returns the number of moves made since the game started.
+     */
+    int getMoves ();
+};
+
+#endif
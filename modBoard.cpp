@@ -0,0 +1,368 @@
+/**
+ *@file modBoard.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class ModBoard.
+ *@details The ModBoard class represents the board of the multi-state variant of the game, whose cells take k values.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "modBoard.h"
+
+/**
+ * Constructor for the board. Creates the board with the side given in sideLength, limited to the range [1, MAX_BOARDSIZE], and cells of states values, limited to the range [2, MAX_MOD_STATES]. All cells are set to 0.
+ * @param sideLength The side of the square. The default value is DEFAULT_BOARDSIZE.
+ * @param states The number of states of a cell. The default value is DEFAULT_MOD_STATES.
+ * @param rule The cells changed by a move. The default value is the plus rule.
+ */
+ModBoard::ModBoard (int sideLength, int states, const Neighbourhood &rule)
+{
+  int i, j, w;
+  uint64_t ones, mask;
+
+  if (sideLength < 1)
+    {
+      sideLength = 1;
+    }
+  if (sideLength > MAX_BOARDSIZE)
+    {
+      sideLength = MAX_BOARDSIZE;
+    }
+  if (states < 2)
+    {
+      states = 2;
+    }
+  if (states > MAX_MOD_STATES)
+    {
+      states = MAX_MOD_STATES;
+    }
+
+  this->boardSize = sideLength;
+  this->nCells = sideLength * sideLength;
+  this->nStates = states;
+  this->neighbourhood = rule;
+  // A lane must hold nStates, the value a cell reaches just before it wraps around to 0
+  this->laneBits = (states <= 3) ? 2 : 4;
+  this->lanesPerWord = 64 / this->laneBits;
+  this->nWords = (this->nCells + this->lanesPerWord - 1) / this->lanesPerWord;
+
+  // 1 in the lowest bit of every lane
+  ones = ~((uint64_t) 0) / ((((uint64_t) 1) << this->laneBits) - 1);
+  this->statesPattern = ones * (uint64_t) states;
+  this->highBits = ones << (this->laneBits - 1);
+  this->lowBits = ~this->highBits;
+  // The even lanes, with as many bits free above each
+  this->evenLanes = ~((uint64_t) 0) / ((((uint64_t) 1) << (2*this->laneBits)) - 1) * ((((uint64_t) 1) << this->laneBits) - 1);
+  ones = ~((uint64_t) 0) / ((((uint64_t) 1) << (2*this->laneBits)) - 1);
+  this->wideStatesPattern = ones * (uint64_t) states;
+  this->wideHighBits = ones << (2*this->laneBits - 1);
+
+  for (w=0; w<MOD_BOARD_WORDS; w++)
+    {
+      this->cells[w] = 0;
+      this->initialCells[w] = 0;
+    }
+
+  // Precompute the lanes of the neighbourhood of every cell, so that a move is one addition per word
+  for (i=0; i<MAX_BOARDSIZE*MAX_BOARDSIZE; i++)
+    {
+      this->moveMask[i] = (i < this->nCells) ? this->neighbourhood.moveMask (sideLength, i) : 0;
+      for (w=0; w<MOD_BOARD_WORDS; w++)
+	{
+	  this->moveLanes[i][w] = 0;
+	}
+      for (mask=this->moveMask[i]; mask; mask&=mask-1)
+	{
+	  j = popCount ((mask & (~mask + 1)) - 1);
+	  this->moveLanes[i][j / this->lanesPerWord] |= ((uint64_t) 1) << ((j % this->lanesPerWord) * this->laneBits);
+	}
+    }
+}
+
+/**
+ * Adds the given lanes to the board, each lane holding 0 or 1, and brings every lane that reached nStates back to 0.
+ * @param lanes The lanes added, nWords words.
+ */
+void ModBoard::advance (const uint64_t *lanes)
+{
+  uint64_t sum, wrapped;
+  int w;
+
+  for (w=0; w<this->nWords; w++)
+    {
+      // No lane overflows: a lane holds at most nStates-1, plus 1
+      sum = this->cells[w] + lanes[w];
+      // The lanes equal to nStates are the zero lanes of sum XOR statesPattern, and XORing nStates clears them
+      wrapped = ~this->nonZeroLanes (sum ^ this->statesPattern) & this->highBits;
+      this->cells[w] = sum ^ ((wrapped >> (this->laneBits - 1)) * (uint64_t) this->nStates);
+    }
+}
+
+/**
+ * Adds times the given lanes to the board, each lane holding 0 or 1, modulo nStates, with one addition per word. The even and the odd lanes are added apart as double width lanes, whose highest bit is free, so that a lane that reached nStates or more is found by one subtraction and brought back into [0, nStates).
+ * @param lanes The lanes added, nWords words.
+ * @param times The number of times the lanes are added, in [0, nStates).
+ */
+void ModBoard::advanceBy (const uint64_t *lanes, int times)
+{
+  uint64_t half[2], sum, wrapped;
+  int w, h, shift;
+
+  for (w=0; w<this->nWords; w++)
+    {
+      for (h=0; h<2; h++)
+	{
+	  shift = h * this->laneBits;
+	  // Both values are below nStates, so their sum needs at most one more bit than a lane, and the highest bit of the double width lane stays free
+	  sum = ((this->cells[w] >> shift) & this->evenLanes) + ((lanes[w] >> shift) & this->evenLanes) * (uint64_t) times;
+	  // The highest bit survives the subtraction of nStates from the lanes with the highest bit set if and only if the sum is at least nStates
+	  wrapped = ((sum | this->wideHighBits) - this->wideStatesPattern) & this->wideHighBits;
+	  half[h] = sum - (wrapped >> (2*this->laneBits - 1)) * (uint64_t) this->nStates;
+	}
+      this->cells[w] = half[0] | (half[1] << this->laneBits);
+    }
+}
+
+/**
+ * Returns the mask of the highest bit of every lane of word that is not 0.
+ * @param word The word.
+ */
+uint64_t ModBoard::nonZeroLanes (uint64_t word)
+{
+  // Adding the low bits of a lane to its low mask carries into its highest bit if any of them is set, never into the next lane
+  return ((((word & this->lowBits) + this->lowBits) | word) & this->highBits);
+}
+
+/**
+ * Sets the value of the cell at (x, y), modulo the number of states. If the co-ordinates are valid, the return is true, else false.
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ * @param value The value the cell is supposed to be set to.
+ */
+bool ModBoard::setCellValue (int x, int y, int value)
+{
+  if (this->checkCoordinateSanity (x, y))
+    {
+      int index = (x-1)*this->boardSize + (y-1);
+      int shift = (index % this->lanesPerWord) * this->laneBits;
+      uint64_t lane = (((uint64_t) 1) << this->laneBits) - 1;
+
+      value = ((value % this->nStates) + this->nStates) % this->nStates;
+      this->cells[index / this->lanesPerWord] &= ~(lane << shift);
+      this->cells[index / this->lanesPerWord] |= ((uint64_t) value) << shift;
+      return (true);
+    }
+  else
+    {
+      return (false);
+    }
+}
+
+/**
+ * Returns in the pointer value the value of the cell at (x, y). If the co-ordinates are valid, the return is true, else false.
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ * @param value Pointer to the location in memory where the value of the cell is copied.
+ */
+bool ModBoard::getCellValue (int x, int y, int *value)
+{
+  if (this->checkCoordinateSanity (x, y))
+    {
+      int index = (x-1)*this->boardSize + (y-1);
+      int shift = (index % this->lanesPerWord) * this->laneBits;
+
+      *value = (int) ((this->cells[index / this->lanesPerWord] >> shift) & ((((uint64_t) 1) << this->laneBits) - 1));
+      return (true);
+    }
+  else
+    {
+      return (false);
+    }
+}
+
+/**
+ * Adds 1 modulo the number of states to every cell of the neighbourhood of (x, y). If the co-ordinates are valid, the return is true, else false.
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ */
+bool ModBoard::pressCell (int x, int y)
+{
+  if (this->checkCoordinateSanity (x, y))
+    {
+      this->advance (this->moveLanes[(x-1)*this->boardSize + (y-1)]);
+      return (true);
+    }
+  else
+    {
+      return (false);
+    }
+}
+
+/**
+ * Presses every cell the number of times given in presses, which holds one count per cell in the order of the cell index.
+ * @param presses The number of presses of every cell, each in [0, getStates()).
+ */
+void ModBoard::pressCells (const unsigned char *presses)
+{
+  int i;
+
+  // A cell pressed c times adds c to every lane of its neighbourhood at once
+  for (i=0; i<this->nCells; i++)
+    {
+      if (presses[i] % this->nStates)
+	{
+	  this->advanceBy (this->moveLanes[i], presses[i] % this->nStates);
+	}
+    }
+}
+
+/**
+ * Copies the value of every cell, in the order of the cell index, to values.
+ * @param values The location where the nCells values are copied.
+ */
+void ModBoard::getValues (unsigned char *values)
+{
+  int i, value = 0;
+
+  for (i=0; i<this->nCells; i++)
+    {
+      this->getCellValue (i / this->boardSize + 1, i % this->boardSize + 1, &value);
+      values[i] = (unsigned char) value;
+    }
+}
+
+/**
+ * Returns true if every cell is 0, testing whole words.
+ */
+bool ModBoard::isClear ()
+{
+  uint64_t lit = 0;
+  int w;
+
+  for (w=0; w<this->nWords; w++)
+    {
+      lit |= this->cells[w];
+    }
+  return (lit == 0);
+}
+
+/**
+ * Returns the number of cells whose value is not 0, counted over whole words.
+ */
+int ModBoard::countLit ()
+{
+  int w, count = 0;
+
+  for (w=0; w<this->nWords; w++)
+    {
+      count += popCount (this->nonZeroLanes (this->cells[w]));
+    }
+  return (count);
+}
+
+/**
+ * Returns the mask of the cells changed by a move at the cell with the given index, one bit per cell.
+ * @param index Index (x-1)*boardSize + (y-1) of the cell.
+ */
+uint64_t ModBoard::getMoveMask (int index)
+{
+  return (this->moveMask[index]);
+}
+
+/**
+ * Returns the length of the side of the board.
+ */
+int ModBoard::getSize ()
+{
+  return (this->boardSize);
+}
+
+/**
+ * Returns the number of states of a cell.
+ */
+int ModBoard::getStates ()
+{
+  return (this->nStates);
+}
+
+/**
+ * Returns the rule of the moves of the board.
+ */
+const Neighbourhood &ModBoard::getNeighbourhood ()
+{
+  return (this->neighbourhood);
+}
+
+/**
+ * Resets the board to its initial state.
+ */
+void ModBoard::resetBoard ()
+{
+  memcpy (this->cells, this->initialCells, sizeof (this->cells));
+}
+
+/**
+ * Saves the current state of the board as its initial state.
+ */
+void ModBoard::setInitialState ()
+{
+  memcpy (this->initialCells, this->cells, sizeof (this->cells));
+}
+
+/**
+ * Sets every cell to 0.
+ */
+void ModBoard::clear ()
+{
+  memset (this->cells, 0, sizeof (this->cells));
+}
+
+/**
+ * Checks the sanity of the coordinates entered. If 0 or negative values, as well as those exceeding the board dimensions are entered, the function returns false, else the return value is true.
+ * @param x Row number of the cell.
+ * @param y Column number of the cell.
+ */
+bool ModBoard::checkCoordinateSanity (int x, int y)
+{
+  if (x <= 0)
+    {
+      return (false);
+    }
+
+  if (y <= 0)
+    {
+      return (false);
+    }
+
+  if (x > this->boardSize)
+    {
+      return (false);
+    }
+
+  if (y > this->boardSize)
+    {
+      return (false);
+    }
+
+  // We are still here, so the co-ordinates are alright.
+  return (true);
+}
@@ -0,0 +1,233 @@
+/**
+ *@file modBoard.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class ModBoard.
+ *@details The ModBoard class represents the board of the multi-state variant of the game, whose cells take k values.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MODBOARD_H
+#define MODBOARD_H
+
+#include <stdint.h>
+
+#include "tools.h"
+#include "board.h"
+#include "neighbourhood.h"
+
+/**
+ * The largest number of states of a cell: a cell is stored in a lane of at most 4 bits, and a value one above the largest state must still fit in it.
+ */
+#ifndef MAX_MOD_STATES
+#define MAX_MOD_STATES 15
+#endif
+
+/**
+ * Default number of states of a cell.
+ */
+#ifndef DEFAULT_MOD_STATES
+#define DEFAULT_MOD_STATES 3
+#endif
+
+/**
+ * Number of 64-bit words holding the lanes of a board: 4-bit lanes of every cell of the largest packed board.
+ */
+#define MOD_BOARD_WORDS (MAX_BOARDSIZE*MAX_BOARDSIZE*4/64)
+
+/**
+ * The ModBoard class represents the board of the multi-state variant: every cell holds a value in [0, k), and a move adds 1 modulo k to every cell of the neighbourhood of the pressed cell. The board is packed: every cell is a lane of 2 bits if k is at most 3 and of 4 bits otherwise, and the lanes of all cells fill a few 64-bit words. A move adds the precomputed lane mask of the cell to every word and brings the lanes that reached k back to 0 with SWAR arithmetic, a handful of word operations whatever the rule, and the win check tests the words for 0.
+ * The cell (x, y) is the lane of index (x-1)*boardSize + (y-1). The side of the board is at most MAX_BOARDSIZE.
+ */
+class ModBoard
+{
+ private:
+  /**
+   * The length of the side of the square board.
+   */
+  int boardSize;
+  /**
+   * Number of cells on the board, boardSize*boardSize.
+   */
+  int nCells;
+  /**
+   * Number of states of a cell, k.
+   */
+  int nStates;
+  /**
+   * Number of bits of a lane, 2 or 4.
+   */
+  int laneBits;
+  /**
+   * Number of lanes in a 64-bit word.
+   */
+  int lanesPerWord;
+  /**
+   * Number of words holding the lanes of the board.
+   */
+  int nWords;
+  /**
+   * The lanes of the cells.
+   */
+  uint64_t cells[MOD_BOARD_WORDS];
+  /**
+   * The lanes of the initial state of the board, in case a reset is required.
+   */
+  uint64_t initialCells[MOD_BOARD_WORDS];
+  /**
+   * The value nStates repeated in every lane of a word.
+   */
+  uint64_t statesPattern;
+  /**
+   * Mask of the low bits of every lane, all but the highest.
+   */
+  uint64_t lowBits;
+  /**
+   * Mask of the highest bit of every lane.
+   */
+  uint64_t highBits;
+  /**
+   * Mask of the lanes of even index within a word. Handled apart, the even and the odd lanes are lanes twice as wide, with room for the sum of two values.
+   */
+  uint64_t evenLanes;
+  /**
+   * Mask of the highest bit of every double width lane.
+   */
+  uint64_t wideHighBits;
+  /**
+   * The value nStates repeated in every double width lane.
+   */
+  uint64_t wideStatesPattern;
+  /**
+   * For every cell, the lanes added by a move at that cell: 1 in the lane of every cell of its neighbourhood.
+   */
+  uint64_t moveLanes[MAX_BOARDSIZE*MAX_BOARDSIZE][MOD_BOARD_WORDS];
+  /**
+   * For every cell, the mask of the cells of its neighbourhood, one bit per cell as in the Board class.
+   */
+  uint64_t moveMask[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  /**
+   * The rule of the moves.
+   */
+  Neighbourhood neighbourhood;
+
+  /**
+   * Adds the given lanes to the board, each lane holding 0 or 1, and brings every lane that reached nStates back to 0.
+   * @param lanes The lanes added, nWords words.
+   */
+  void advance (const uint64_t *lanes);
+  /**
+   * Adds times the given lanes to the board, each lane holding 0 or 1, modulo nStates, with one addition per word. The even and the odd lanes are added apart as double width lanes, whose highest bit is free, so that a lane that reached nStates or more is found by one subtraction and brought back into [0, nStates).
+   * @param lanes The lanes added, nWords words.
+   * @param times The number of times the lanes are added, in [0, nStates).
+   */
+  void advanceBy (const uint64_t *lanes, int times);
+  /**
+   * Returns the mask of the highest bit of every lane of word that is not 0.
+   * @param word The word.
+   */
+  uint64_t nonZeroLanes (uint64_t word);
+
+ public:
+  /**
+   * Constructor for the board. Creates the board with the side given in sideLength, limited to the range [1, MAX_BOARDSIZE], and cells of states values, limited to the range [2, MAX_MOD_STATES]. All cells are set to 0.
+   * @param sideLength The side of the square. The default value is DEFAULT_BOARDSIZE.
+   * @param states The number of states of a cell. The default value is DEFAULT_MOD_STATES.
+   * @param rule The cells changed by a move. The default value is the plus rule.
+   */
+  ModBoard (int sideLength=DEFAULT_BOARDSIZE, int states=DEFAULT_MOD_STATES, const Neighbourhood &rule=Neighbourhood ());
+  /**
+   * Sets the value of the cell at (x, y), modulo the number of states. If the co-ordinates are valid, the return is true, else false.
+   * @param x Row number of the cell.
+   * @param y Column number of the cell.
+   * @param value The value the cell is supposed to be set to.
+   */
+  bool setCellValue (int x, int y, int value);
+  /**
+   * Returns in the pointer value the value of the cell at (x, y). If the co-ordinates are valid, the return is true, else false.
+   * @param x Row number of the cell.
+   * @param y Column number of the cell.
+   * @param value Pointer to the location in memory where the value of the cell is copied.
+   */
+  bool getCellValue (int x, int y, int *value);
+  /**
+   * Adds 1 modulo the number of states to every cell of the neighbourhood of (x, y). If the co-ordinates are valid, the return is true, else false.
+   * @param x Row number of the cell.
+   * @param y Column number of the cell.
+   */
+  bool pressCell (int x, int y);
+  /**
+   * Presses every cell the number of times given in presses, which holds one count per cell in the order of the cell index.
+   * @param presses The number of presses of every cell, each in [0, getStates()).
+   */
+  void pressCells (const unsigned char *presses);
+  /**
+   * Copies the value of every cell, in the order of the cell index, to values.
+   * @param values The location where the nCells values are copied.
+   */
+  void getValues (unsigned char *values);
+  /**
+   * Returns true if every cell is 0, testing whole words.
+   */
+  bool isClear ();
+  /**
+   * Returns the number of cells whose value is not 0, counted over whole words.
+   */
+  int countLit ();
+  /**
+   * Returns the mask of the cells changed by a move at the cell with the given index, one bit per cell.
+   * @param index Index (x-1)*boardSize + (y-1) of the cell.
+   */
+  uint64_t getMoveMask (int index);
+  /**
+   * Returns the length of the side of the board.
+   */
+  int getSize ();
+  /**
+   * Returns the number of states of a cell.
+   */
+  int getStates ();
+  /**
+   * Returns the rule of the moves of the board.
+   */
+  const Neighbourhood &getNeighbourhood ();
+  /**
+   * Resets the board to its initial state.
+   */
+  void resetBoard ();
+  /**
+   * Saves the current state of the board as its initial state.
+   */
+  void setInitialState ();
+  /**
+   * Sets every cell to 0.
+   */
+  void clear ();
+  /**
+   * Checks the sanity of the coordinates entered. If 0 or negative values, as well as those exceeding the board dimensions are entered, the function returns false, else the return value is true.
+   * @param x Row number of the cell.
+   * @param y Column number of the cell.
+   */
+  bool checkCoordinateSanity (int x, int y);
+};
+
+#endif
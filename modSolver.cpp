@@ -0,0 +1,339 @@
+/**
+ *@file modSolver.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class ModSolver.
+ *@details The ModSolver class solves boards of the multi-state variant of the game over the integers modulo k.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "modSolver.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+ * Number of cells of the largest board, the largest order of a press matrix.
+ */
+#define MOD_SOLVER_CELLS (MAX_BOARDSIZE*MAX_BOARDSIZE)
+
+/**
+ * Returns the greatest common divisor g of the non-negative integers a and b, not both 0, and in s and t coefficients with s*a + t*b = g. If a divides b, s is 1 and t is 0.
+ * @param a The first integer.
+ * @param b The second integer.
+ * @param s Pointer to the location where the coefficient of a is copied.
+ * @param t Pointer to the location where the coefficient of b is copied.
+ */
+static int extendedGcd (int a, int b, int *s, int *t)
+{
+  int q, r, s0 = 1, s1 = 0, t0 = 0, t1 = 1, next;
+
+  if (a != 0 && b % a == 0)
+    {
+      *s = 1;
+      *t = 0;
+      return (a);
+    }
+  while (b != 0)
+    {
+      q = a / b;
+      r = a - q*b;
+      a = b;
+      b = r;
+      next = s0 - q*s1;
+      s0 = s1;
+      s1 = next;
+      next = t0 - q*t1;
+      t0 = t1;
+      t1 = next;
+    }
+  *s = s0;
+  *t = t0;
+  return (a);
+}
+
+/**
+ * Replaces the rows first and second of matrix, of MOD_SOLVER_CELLS columns, by s*first + t*second and u*first + v*second, modulo k.
+ * @param matrix The matrix.
+ * @param first Index of the first row.
+ * @param second Index of the second row.
+ * @param s Coefficient of the first row in the new first row.
+ * @param t Coefficient of the second row in the new first row.
+ * @param u Coefficient of the first row in the new second row.
+ * @param v Coefficient of the second row in the new second row.
+ * @param k The modulus.
+ */
+static void combineRows (unsigned char matrix[][MOD_SOLVER_CELLS], int first, int second, int s, int t, int u, int v, int k)
+{
+  int j, x, y;
+
+  for (j=0; j<MOD_SOLVER_CELLS; j++)
+    {
+      x = matrix[first][j];
+      y = matrix[second][j];
+      matrix[first][j] = (unsigned char) ((((s*x + t*y) % k) + k) % k);
+      matrix[second][j] = (unsigned char) ((((u*x + v*y) % k) + k) % k);
+    }
+}
+
+/**
+ * Replaces the columns first and second of matrix, of MOD_SOLVER_CELLS rows, by s*first + t*second and u*first + v*second, modulo k.
+ * @param matrix The matrix.
+ * @param first Index of the first column.
+ * @param second Index of the second column.
+ * @param s Coefficient of the first column in the new first column.
+ * @param t Coefficient of the second column in the new first column.
+ * @param u Coefficient of the first column in the new second column.
+ * @param v Coefficient of the second column in the new second column.
+ * @param k The modulus.
+ */
+static void combineColumns (unsigned char matrix[][MOD_SOLVER_CELLS], int first, int second, int s, int t, int u, int v, int k)
+{
+  int i, x, y;
+
+  for (i=0; i<MOD_SOLVER_CELLS; i++)
+    {
+      x = matrix[i][first];
+      y = matrix[i][second];
+      matrix[i][first] = (unsigned char) ((((s*x + t*y) % k) + k) % k);
+      matrix[i][second] = (unsigned char) ((((u*x + v*y) % k) + k) % k);
+    }
+}
+
+/**
+ * Constructor that diagonalizes the press matrix built from the move masks of the board.
+ * @param board The board whose moves are to be solved.
+ */
+ModSolver::ModSolver (ModBoard *board)
+{
+  this->initialize (board);
+}
+
+/**
+ * Returns the shared solver of boards of the given size, number of states and rule, or NULL if the size is not within [1, MAX_BOARDSIZE] or the number of states not within [2, MAX_MOD_STATES]. The solver is built on the first call for that size, number of states and rule and reused by every game. The call is thread-safe.
+ * @param sideLength The side of the square board.
+ * @param states The number of states of a cell.
+ * @param rule The cells changed by a move.
+ */
+ModSolver *ModSolver::forRule (int sideLength, int states, const Neighbourhood &rule)
+{
+  static std::mutex lock;
+  static std::map<std::string, ModSolver *> solvers;
+
+  if (sideLength < 1 || sideLength > MAX_BOARDSIZE || states < 2 || states > MAX_MOD_STATES)
+    {
+      return (NULL);
+    }
+
+  std::string key = std::to_string (sideLength) + " " + std::to_string (states) + " " + rule.getName ();
+  std::lock_guard<std::mutex> guard (lock);
+  std::map<std::string, ModSolver *>::iterator found = solvers.find (key);
+  if (found != solvers.end ())
+    {
+      return (found->second);
+    }
+
+  ModBoard board (sideLength, states, rule);
+  ModSolver *solver = new ModSolver (&board);
+  solvers[key] = solver;
+  return (solver);
+}
+
+/**
+ * Diagonalizes the press matrix of the board modulo k and stores the row and column operations.
+ * @param board The board whose moves are to be solved.
+ */
+void ModSolver::initialize (ModBoard *board)
+{
+  unsigned char matrix[MOD_SOLVER_CELLS][MOD_SOLVER_CELLS];
+  uint64_t mask;
+  int i, j, t, a, b, g, s, u, k;
+  bool clean;
+
+  this->boardSize = board->getSize ();
+  this->nCells = this->boardSize * this->boardSize;
+  this->modulus = k = board->getStates ();
+
+  memset (matrix, 0, sizeof (matrix));
+  memset (this->rowOperations, 0, sizeof (this->rowOperations));
+  memset (this->columnOperations, 0, sizeof (this->columnOperations));
+  memset (this->diagonal, 0, sizeof (this->diagonal));
+  // Column j of the matrix is the move mask of cell j
+  for (j=0; j<this->nCells; j++)
+    {
+      mask = board->getMoveMask (j);
+      for (i=0; i<this->nCells; i++)
+	{
+	  matrix[i][j] = (unsigned char) ((mask >> i) & 1);
+	}
+      this->rowOperations[j][j] = 1;
+      this->columnOperations[j][j] = 1;
+    }
+
+  for (t=0; t<this->nCells; t++)
+    {
+      // Find a pivot in the rest of the matrix
+      for (i=t; i<this->nCells; i++)
+	{
+	  for (j=t; j<this->nCells && !matrix[i][j]; j++)
+	    ;
+	  if (j < this->nCells)
+	    {
+	      break;
+	    }
+	}
+      if (i == this->nCells)
+	{
+	  // The rest of the matrix is 0, and so is the rest of the diagonal
+	  break;
+	}
+
+      // Move the pivot into place
+      if (i != t)
+	{
+	  combineRows (matrix, t, i, 0, 1, 1, 0, k);
+	  combineRows (this->rowOperations, t, i, 0, 1, 1, 0, k);
+	}
+      if (j != t)
+	{
+	  combineColumns (matrix, t, j, 0, 1, 1, 0, k);
+	  combineColumns (this->columnOperations, t, j, 0, 1, 1, 0, k);
+	}
+
+      // Clear the column and the row of the pivot. The operations [s u; -b/g a/g] have determinant 1, so they can be undone modulo any k.
+      // The pivot is replaced by the gcd of itself and the entry cleared, so it only shrinks, and once it divides every entry it is left alone
+      do
+	{
+	  for (i=t+1; i<this->nCells; i++)
+	    {
+	      if (matrix[i][t])
+		{
+		  a = matrix[t][t];
+		  b = matrix[i][t];
+		  g = extendedGcd (a, b, &s, &u);
+		  combineRows (matrix, t, i, s, u, -b/g, a/g, k);
+		  combineRows (this->rowOperations, t, i, s, u, -b/g, a/g, k);
+		}
+	    }
+	  for (j=t+1; j<this->nCells; j++)
+	    {
+	      if (matrix[t][j])
+		{
+		  a = matrix[t][t];
+		  b = matrix[t][j];
+		  g = extendedGcd (a, b, &s, &u);
+		  combineColumns (matrix, t, j, s, u, -b/g, a/g, k);
+		  combineColumns (this->columnOperations, t, j, s, u, -b/g, a/g, k);
+		}
+	    }
+	  clean = true;
+	  for (i=t+1; i<this->nCells; i++)
+	    {
+	      if (matrix[i][t])
+		{
+		  clean = false;
+		}
+	    }
+	}
+      while (!clean);
+
+      this->diagonal[t] = matrix[t][t];
+    }
+}
+
+/**
+ * Returns the value modulo k of value, in [0, k).
+ * @param value Any integer.
+ */
+int ModSolver::reduce (int value)
+{
+  return (((value % this->modulus) + this->modulus) % this->modulus);
+}
+
+/**
+ * Finds the number of times to press every cell to turn the given state into the empty board. The return value is false if the state cannot be cleared.
+ * @param state The value of every cell, in the order of the cell index.
+ * @param presses The location where the number of presses of every cell, each in [0, k), is copied.
+ */
+bool ModSolver::solve (const unsigned char *state, unsigned char *presses)
+{
+  int y[MOD_SOLVER_CELLS];
+  int i, j, c, d, g, s, t, m, k = this->modulus;
+
+  for (i=0; i<this->nCells; i++)
+    {
+      // The right hand side of the diagonal system, U (-s)
+      c = 0;
+      for (j=0; j<this->nCells; j++)
+	{
+	  c += this->rowOperations[i][j] * state[j];
+	}
+      c = this->reduce (-c);
+
+      // d y = c modulo k is solvable if and only if g = gcd(d, k) divides c, and then y = (c/g) (d/g)^-1 modulo k/g
+      d = this->diagonal[i];
+      g = extendedGcd (d, k, &s, &t);
+      if (c % g)
+	{
+	  return (false);
+	}
+      m = k / g;
+      y[i] = (m == 1) ? 0 : ((((c / g) * s) % m) + m) % m;
+    }
+
+  for (i=0; i<this->nCells; i++)
+    {
+      c = 0;
+      for (j=0; j<this->nCells; j++)
+	{
+	  c += this->columnOperations[i][j] * y[j];
+	}
+      presses[i] = (unsigned char) this->reduce (c);
+    }
+  return (true);
+}
+
+/**
+ * Returns the number of independent quiet patterns, press counts that leave every cell unchanged: the number of entries of the diagonal that are not invertible modulo k. For a prime k, a solvable state has k to this power solutions.
+ */
+int ModSolver::getQuietPatternCount ()
+{
+  int i, s, t, count = 0;
+
+  for (i=0; i<this->nCells; i++)
+    {
+      if (extendedGcd (this->diagonal[i], this->modulus, &s, &t) != 1)
+	{
+	  count++;
+	}
+    }
+  return (count);
+}
+
+/**
+ * Returns the number of states of a cell, the modulus.
+ */
+int ModSolver::getModulus ()
+{
+  return (this->modulus);
+}
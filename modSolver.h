@@ -0,0 +1,110 @@
+/**
+ *@file modSolver.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class ModSolver.
+ *@details The ModSolver class solves boards of the multi-state variant of the game over the integers modulo k.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MODSOLVER_H
+#define MODSOLVER_H
+
+#include <stdint.h>
+
+#include "tools.h"
+#include "neighbourhood.h"
+#include "modBoard.h"
+
+/**
+ * The ModSolver class finds the number of times to press every cell to clear a board of the multi-state variant. Pressing cell j c times adds c to every cell of its neighbourhood, so the effect of the press counts p on a state s is s + Ap modulo k, where A is the press matrix whose column j is the move mask of cell j, and solving a board means solving Ap = -s over the integers modulo k.
+ * The integers modulo k are not a field unless k is prime, so the press matrix is not reduced by dividing by pivots but diagonalized: invertible row and column operations built from the Bezout coefficients of two entries, U A V = D, computed once. A system D y = c then splits into one congruence per cell, d y = c modulo k, solvable if and only if gcd(d, k) divides c, and p = V y. Every solve is two products with the stored operations.
+ */
+class ModSolver
+{
+ private:
+  /**
+   * The length of the side of the square board.
+   */
+  int boardSize;
+  /**
+   * Number of cells on the board, boardSize*boardSize.
+   */
+  int nCells;
+  /**
+   * Number of states of a cell, the modulus k.
+   */
+  int modulus;
+  /**
+   * The row operations U of the diagonalization: the right hand side of the diagonal system is U times the right hand side of the original one.
+   */
+  unsigned char rowOperations[MAX_BOARDSIZE*MAX_BOARDSIZE][MAX_BOARDSIZE*MAX_BOARDSIZE];
+  /**
+   * The column operations V of the diagonalization: the press counts are V times the solution of the diagonal system.
+   */
+  unsigned char columnOperations[MAX_BOARDSIZE*MAX_BOARDSIZE][MAX_BOARDSIZE*MAX_BOARDSIZE];
+  /**
+   * The diagonal D = U A V, modulo k.
+   */
+  unsigned char diagonal[MAX_BOARDSIZE*MAX_BOARDSIZE];
+
+  /**
+   * Diagonalizes the press matrix of the board modulo k and stores the row and column operations.
+   * @param board The board whose moves are to be solved.
+   */
+  void initialize (ModBoard *board);
+  /**
+   * Returns the value modulo k of value, in [0, k).
+   * @param value Any integer.
+   */
+  int reduce (int value);
+
+ public:
+  /**
+   * Constructor that diagonalizes the press matrix built from the move masks of the board.
+   * @param board The board whose moves are to be solved.
+   */
+  ModSolver (ModBoard *board);
+  /**
+   * Returns the shared solver of boards of the given size, number of states and rule, or NULL if the size is not within [1, MAX_BOARDSIZE] or the number of states not within [2, MAX_MOD_STATES]. The solver is built on the first call for that size, number of states and rule and reused by every game. The call is thread-safe.
+   * @param sideLength The side of the square board.
+   * @param states The number of states of a cell.
+   * @param rule The cells changed by a move.
+   */
+  static ModSolver *forRule (int sideLength, int states, const Neighbourhood &rule);
+  /**
+   * Finds the number of times to press every cell to turn the given state into the empty board. The return value is false if the state cannot be cleared.
+   * @param state The value of every cell, in the order of the cell index.
+   * @param presses The location where the number of presses of every cell, each in [0, k), is copied.
+   */
+  bool solve (const unsigned char *state, unsigned char *presses);
+  /**
+   * Returns the number of independent quiet patterns, press counts that leave every cell unchanged: the number of entries of the diagonal that are not invertible modulo k. For a prime k, a solvable state has k to this power solutions.
+   */
+  int getQuietPatternCount ();
+  /**
+   * Returns the number of states of a cell, the modulus.
+   */
+  int getModulus ();
+};
+
+#endif
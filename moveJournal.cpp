@@ -0,0 +1,114 @@
+/**
+ *@file moveJournal.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class MoveJournal.
+ *@details The MoveJournal class records the moves of a game so that they can be undone and redone.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "moveJournal.h"
+
+/**
+ * Constructor of an empty journal.
+ */
+MoveJournal::MoveJournal ()
+{
+  this->clear ();
+}
+
+/**
+ * Records a move. The moves that could be redone are forgotten.
+ * @param index Bit index of the cell at which the move was made.
+ */
+void MoveJournal::record (uint32_t index)
+{
+  this->cell[(this->start + this->nUndo) % MOVE_JOURNAL_SIZE] = index;
+  if (this->nUndo == MOVE_JOURNAL_SIZE)
+    {
+      // Full: the oldest move is overwritten
+      this->start = (this->start + 1) % MOVE_JOURNAL_SIZE;
+    }
+  else
+    {
+      (this->nUndo)++;
+    }
+  this->nRedo = 0;
+}
+
+/**
+ * Steps back over the last move and copies its cell to index. The return value is false if there is no move to undo.
+ * @param index Pointer to the location where the bit index of the cell is copied.
+ */
+bool MoveJournal::undo (uint32_t *index)
+{
+  if (this->nUndo == 0)
+    {
+      return (false);
+    }
+  (this->nUndo)--;
+  (this->nRedo)++;
+  *index = this->cell[(this->start + this->nUndo) % MOVE_JOURNAL_SIZE];
+  return (true);
+}
+
+/**
+ * Steps forward over the last undone move and copies its cell to index. The return value is false if there is no move to redo.
+ * @param index Pointer to the location where the bit index of the cell is copied.
+ */
+bool MoveJournal::redo (uint32_t *index)
+{
+  if (this->nRedo == 0)
+    {
+      return (false);
+    }
+  *index = this->cell[(this->start + this->nUndo) % MOVE_JOURNAL_SIZE];
+  (this->nUndo)++;
+  (this->nRedo)--;
+  return (true);
+}
+
+/**
+ * Forgets all moves.
+ */
+void MoveJournal::clear ()
+{
+  this->start = 0;
+  this->nUndo = 0;
+  this->nRedo = 0;
+}
+
+/**
+ * Returns the number of moves that can be undone.
+ */
+int MoveJournal::getUndoCount ()
+{
+  return (this->nUndo);
+}
+
+/**
+ * Returns the number of moves that can be redone.
+ */
+int MoveJournal::getRedoCount ()
+{
+  return (this->nRedo);
+}
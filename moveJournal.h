@@ -0,0 +1,98 @@
+/**
+ *@file moveJournal.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class MoveJournal.
+ *@details The MoveJournal class records the moves of a game so that they can be undone and redone.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MOVEJOURNAL_H
+#define MOVEJOURNAL_H
+
+#include <stdint.h>
+
+/**
+ * Number of moves kept in the journal. When it is full, recording a move drops the oldest one.
+ */
+#ifndef MOVE_JOURNAL_SIZE
+#define MOVE_JOURNAL_SIZE 4096
+#endif
+
+/**
+ * The MoveJournal class is a ring buffer of the cells at which moves were made. Every move is its own inverse, so a move is undone by pressing its cell again, and the journal never needs a copy of the board. The moves after the current position are kept for redo until a new move is recorded.
+ */
+class MoveJournal
+{
+ private:
+  /**
+   * The cells at which the moves were made, as bit indices (x-1)*boardSize + (y-1).
+   */
+  uint32_t cell[MOVE_JOURNAL_SIZE];
+  /**
+   * Position in the ring buffer of the oldest move.
+   */
+  int start;
+  /**
+   * Number of moves that can be undone.
+   */
+  int nUndo;
+  /**
+   * Number of moves that can be redone.
+   */
+  int nRedo;
+
+ public:
+  /**
+   * Constructor of an empty journal.
+   */
+  MoveJournal ();
+  /**
+   * Records a move. The moves that could be redone are forgotten.
+   * @param index Bit index of the cell at which the move was made.
+   */
+  void record (uint32_t index);
+  /**
+   * Steps back over the last move and copies its cell to index. The return value is false if there is no move to undo.
+   * @param index Pointer to the location where the bit index of the cell is copied.
+   */
+  bool undo (uint32_t *index);
+  /**
+   * Steps forward over the last undone move and copies its cell to index. The return value is false if there is no move to redo.
+   * @param index Pointer to the location where the bit index of the cell is copied.
+   */
+  bool redo (uint32_t *index);
+  /**
+   * Forgets all moves.
+   */
+  void clear ();
+  /**
+   * Returns the number of moves that can be undone.
+   */
+  int getUndoCount ();
+  /**
+   * Returns the number of moves that can be redone.
+   */
+  int getRedoCount ();
+};
+
+#endif
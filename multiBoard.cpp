@@ -0,0 +1,376 @@
+/**
+ *@file multiBoard.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class MultiBoard.
+ *@details The MultiBoard class plays the same moves on many boards at once, bitsliced.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "multiBoard.h"
+
+#if defined(AVX2_DISPATCH) && MULTIBOARD_WORDS == 4
+#include <immintrin.h>
+
+/**
+ * XORs the plane lanes, restricted to the plane active, into the planes of the count cells listed in cells, four words at a time.
+ * @param plane The bit planes of the boards.
+ * @param cells The indices of the cells flipped.
+ * @param count Number of cells flipped.
+ * @param lanes Plane with the bits of the boards to play set.
+ * @param active Plane with the bits of the boards in use set.
+ */
+AVX2_TARGET static void flipPlanesAvx2 (uint64_t (*plane)[MULTIBOARD_WORDS], const int *cells, int count, const uint64_t *lanes, const uint64_t *active)
+{
+  __m256i move = _mm256_and_si256 (_mm256_loadu_si256 ((const __m256i *) lanes), _mm256_loadu_si256 ((const __m256i *) active));
+  uint64_t *cell;
+  int i;
+
+  for (i=0; i<count; i++)
+    {
+      cell = plane[cells[i]];
+      _mm256_storeu_si256 ((__m256i *) cell, _mm256_xor_si256 (_mm256_loadu_si256 ((const __m256i *) cell), move));
+    }
+}
+
+/**
+ * Sets in wins the bits of the boards in use whose nCells planes are all 0 or all 1, four words at a time.
+ * @param plane The bit planes of the boards.
+ * @param nCells Number of cells of a board.
+ * @param active Plane with the bits of the boards in use set.
+ * @param wins Plane where the bits of the boards won are set.
+ */
+AVX2_TARGET static void checkWinsAvx2 (uint64_t (*plane)[MULTIBOARD_WORDS], int nCells, const uint64_t *active, uint64_t *wins)
+{
+  __m256i anyLit = _mm256_setzero_si256 ();
+  __m256i allLit = _mm256_set1_epi64x (-1);
+  int i;
+
+  for (i=0; i<nCells; i++)
+    {
+      __m256i cell = _mm256_loadu_si256 ((const __m256i *) plane[i]);
+      anyLit = _mm256_or_si256 (anyLit, cell);
+      allLit = _mm256_and_si256 (allLit, cell);
+    }
+  _mm256_storeu_si256 ((__m256i *) wins, _mm256_and_si256 (_mm256_or_si256 (_mm256_andnot_si256 (anyLit, _mm256_set1_epi64x (-1)), allLit),
+							    _mm256_loadu_si256 ((const __m256i *) active)));
+}
+#endif
+
+/**
+ * Constructor that creates boards with all cells set to 0.
+ * @param sideLength The side of the boards, limited to the range [1, MAX_BOARDSIZE].
+ * @param boards Number of boards, limited to the range [1, MAX_MULTIBOARD_BOARDS].
+ */
+MultiBoard::MultiBoard (int sideLength, int boards)
+{
+  int i, j, w;
+  uint64_t mask;
+
+  if (sideLength < 1)
+    {
+      sideLength = 1;
+    }
+  if (sideLength > MAX_BOARDSIZE)
+    {
+      sideLength = MAX_BOARDSIZE;
+    }
+  if (boards < 1)
+    {
+      boards = 1;
+    }
+  if (boards > MAX_MULTIBOARD_BOARDS)
+    {
+      boards = MAX_MULTIBOARD_BOARDS;
+    }
+  this->boardSize = sideLength;
+  this->nBoards = boards;
+  this->avx2 = hasAvx2 ();
+
+  for (w=0; w<MULTIBOARD_WORDS; w++)
+    {
+      if (boards >= 64*(w+1))
+	{
+	  this->active[w] = ~((uint64_t) 0);
+	}
+      else if (boards > 64*w)
+	{
+	  this->active[w] = (((uint64_t) 1) << (boards - 64*w)) - 1;
+	}
+      else
+	{
+	  this->active[w] = 0;
+	}
+    }
+
+  // The cells flipped by each move are taken from the move masks of the board
+  Board board (sideLength);
+  for (i=0; i<MAX_BOARDSIZE*MAX_BOARDSIZE; i++)
+    {
+      for (w=0; w<MULTIBOARD_WORDS; w++)
+	{
+	  this->plane[i][w] = 0;
+	}
+      this->moveSize[i] = 0;
+      if (i >= sideLength*sideLength)
+	{
+	  continue;
+	}
+      mask = board.getMoveMask (i);
+      for (j=0; mask; j++)
+	{
+	  this->moveCell[i][j] = popCount ((mask & (~mask + 1)) - 1);
+	  mask &= mask - 1;
+	}
+      this->moveSize[i] = j;
+    }
+}
+
+/**
+ * Returns the number of boards.
+ */
+int MultiBoard::getBoardCount ()
+{
+  return (this->nBoards);
+}
+
+/**
+ * Returns the length of the side of the boards.
+ */
+int MultiBoard::getSize ()
+{
+  return (this->boardSize);
+}
+
+/**
+ * Sets the state of one board, one bit per cell as in Board::getState. The return value is false if there is no such board.
+ * @param lane The board, from 0.
+ * @param state The new state of the board.
+ */
+bool MultiBoard::setBoard (int lane, uint64_t state)
+{
+  int i;
+  uint64_t bit;
+
+  if (lane < 0 || lane >= this->nBoards)
+    {
+      return (false);
+    }
+  bit = ((uint64_t) 1) << (lane % 64);
+  for (i=0; i<this->boardSize*this->boardSize; i++)
+    {
+      if ((state >> i) & 1)
+	{
+	  this->plane[i][lane / 64] |= bit;
+	}
+      else
+	{
+	  this->plane[i][lane / 64] &= ~bit;
+	}
+    }
+  return (true);
+}
+
+/**
+ * Returns the state of one board, one bit per cell as in Board::getState, or 0 if there is no such board.
+ * @param lane The board, from 0.
+ */
+uint64_t MultiBoard::getBoard (int lane)
+{
+  int i;
+  uint64_t state = 0;
+
+  if (lane < 0 || lane >= this->nBoards)
+    {
+      return (0);
+    }
+  for (i=0; i<this->boardSize*this->boardSize; i++)
+    {
+      state |= ((this->plane[i][lane / 64] >> (lane % 64)) & 1) << i;
+    }
+  return (state);
+}
+
+/**
+ * Sets the states of all boards, one bit per cell as in Board::getState.
+ * @param states The states, one per board, getBoardCount() in all.
+ */
+void MultiBoard::setBoards (const uint64_t *states)
+{
+  int lane;
+
+  for (lane=0; lane<this->nBoards; lane++)
+    {
+      this->setBoard (lane, states[lane]);
+    }
+}
+
+/**
+ * Carries out the move at (x, y) on every board. If the co-ordinates are valid, the return is true, else false.
+ * @param x Row number of the point where the move is carried out.
+ * @param y Column number of the point where the move is carried out.
+ */
+bool MultiBoard::applyMove (int x, int y)
+{
+  return (this->applyMove (x, y, this->active));
+}
+
+/**
+ * Carries out the move at (x, y) on the boards whose bits are set in lanes. If the co-ordinates are valid, the return is true, else false.
+ * @param x Row number of the point where the move is carried out.
+ * @param y Column number of the point where the move is carried out.
+ * @param lanes Plane of MULTIBOARD_WORDS words with the bits of the boards to play set.
+ */
+bool MultiBoard::applyMove (int x, int y, const uint64_t *lanes)
+{
+  int index, i;
+  uint64_t *cell;
+
+  if (x < 1 || y < 1 || x > this->boardSize || y > this->boardSize)
+    {
+      return (false);
+    }
+  index = (x-1)*this->boardSize + (y-1);
+
+#if defined(AVX2_DISPATCH) && MULTIBOARD_WORDS == 4
+  if (this->avx2)
+    {
+      flipPlanesAvx2 (this->plane, this->moveCell[index], this->moveSize[index], lanes, this->active);
+      return (true);
+    }
+#endif
+  for (i=0; i<this->moveSize[index]; i++)
+    {
+      cell = this->plane[this->moveCell[index][i]];
+      for (int w=0; w<MULTIBOARD_WORDS; w++)
+	{
+	  cell[w] ^= lanes[w] & this->active[w];
+	}
+    }
+  return (true);
+}
+
+/**
+ * Presses on every board the cells of its own press set, for instance the solution found for it by the Solver.
+ * @param presses The press sets, one per board as in Solver::solve, getBoardCount() in all.
+ */
+void MultiBoard::applyPresses (const uint64_t *presses)
+{
+  uint64_t lanes[MULTIBOARD_WORDS];
+  int i, w, lane;
+
+  // The boards that press each cell form a plane, and the cell is pressed in those lanes
+  for (i=0; i<this->boardSize*this->boardSize; i++)
+    {
+      for (w=0; w<MULTIBOARD_WORDS; w++)
+	{
+	  lanes[w] = 0;
+	}
+      for (lane=0; lane<this->nBoards; lane++)
+	{
+	  lanes[lane / 64] |= ((presses[lane] >> i) & 1) << (lane % 64);
+	}
+      this->applyMove (i / this->boardSize + 1, i % this->boardSize + 1, lanes);
+    }
+}
+
+/**
+ * Checks the win condition of every board: the bit of a board is set in wins if all its cells are 0 or all are 1. The return value is the number of boards won.
+ * @param wins Plane of MULTIBOARD_WORDS words where the bits of the boards won are set.
+ */
+int MultiBoard::checkWins (uint64_t *wins)
+{
+  int i, w, nWins = 0;
+  int nCells = this->boardSize*this->boardSize;
+  uint64_t anyLit, allLit;
+
+  // A board is all 0's if no plane has its bit set, and all 1's if every plane has it set
+#if defined(AVX2_DISPATCH) && MULTIBOARD_WORDS == 4
+  if (this->avx2)
+    {
+      checkWinsAvx2 (this->plane, nCells, this->active, wins);
+    }
+  else
+#endif
+  for (w=0; w<MULTIBOARD_WORDS; w++)
+    {
+      anyLit = 0;
+      allLit = ~((uint64_t) 0);
+      for (i=0; i<nCells; i++)
+	{
+	  anyLit |= this->plane[i][w];
+	  allLit &= this->plane[i][w];
+	}
+      wins[w] = (~anyLit | allLit) & this->active[w];
+    }
+  for (w=0; w<MULTIBOARD_WORDS; w++)
+    {
+      nWins += popCount (wins[w]);
+    }
+  return (nWins);
+}
+
+/**
+ * Counts the lit cells of every board with bitsliced counters: each plane is added to a binary counter whose bits are themselves planes, so the cells of all boards are added at once.
+ * @param counts The number of cells of value 1 of each board, getBoardCount() in all.
+ */
+void MultiBoard::countLitCells (int *counts)
+{
+  uint64_t counter[MULTIBOARD_COUNTER_BITS];
+  uint64_t carry, sum;
+  int i, w, bit, lane, lastLane;
+
+  // One word of 64 boards at a time, so that the planes of the counter stay in registers
+  for (w=0; w<MULTIBOARD_WORDS && 64*w < this->nBoards; w++)
+    {
+      for (bit=0; bit<MULTIBOARD_COUNTER_BITS; bit++)
+	{
+	  counter[bit] = 0;
+	}
+      // Ripple carry addition of each plane to the counter
+      for (i=0; i<this->boardSize*this->boardSize; i++)
+	{
+	  carry = this->plane[i][w];
+	  for (bit=0; bit<MULTIBOARD_COUNTER_BITS; bit++)
+	    {
+	      sum = counter[bit] ^ carry;
+	      carry &= counter[bit];
+	      counter[bit] = sum;
+	    }
+	}
+      // Eight counts at a time: a multiplication spreads the bits of eight boards to the bytes of a word, where the planes of the counter add up
+      lastLane = (64*(w+1) < this->nBoards) ? 64*(w+1) : this->nBoards;
+      for (lane=64*w; lane<lastLane; lane+=8)
+	{
+	  sum = 0;
+	  for (bit=0; bit<MULTIBOARD_COUNTER_BITS; bit++)
+	    {
+	      carry = (counter[bit] >> (lane % 64)) & 0xFF;
+	      sum += ((((carry & 0x7F) * 0x0002040810204081ULL) & 0x0101010101010101ULL) | ((carry >> 7) << 56)) << bit;
+	    }
+	  for (i=0; i<8 && lane+i < lastLane; i++)
+	    {
+	      counts[lane+i] = (int) ((sum >> (8*i)) & 0xFF);
+	    }
+	}
+    }
+}
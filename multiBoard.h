@@ -0,0 +1,151 @@
+/**
+ *@file multiBoard.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class MultiBoard.
+ *@details The MultiBoard class plays the same moves on many boards at once, bitsliced.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MULTIBOARD_H
+#define MULTIBOARD_H
+
+#include <stdint.h>
+
+#include "tools.h"
+#include "board.h"
+
+/**
+ * Number of 64-bit words in a bit plane: a MultiBoard holds up to 64 times as many boards.
+ */
+#ifndef MULTIBOARD_WORDS
+#define MULTIBOARD_WORDS 4
+#endif
+
+/**
+ * The largest number of boards held by a MultiBoard.
+ */
+#define MAX_MULTIBOARD_BOARDS (64*MULTIBOARD_WORDS)
+
+/**
+ * Number of bit planes of the lit cell counters, enough to count every cell of the largest packed board.
+ */
+#define MULTIBOARD_COUNTER_BITS 7
+
+/**
+ * The MultiBoard class holds up to MAX_MULTIBOARD_BOARDS boards of the same size, bitsliced: for every cell there is a bit plane with one bit per board, the lane of the board. A move is a few XORs of whole planes, so it is played on every board at once, and the win check and the count of lit cells are computed for every board with logic over the planes. On a processor with AVX2, found at run time, a plane of four words is handled in one instruction.
+ * The boards are packed boards, of side up to MAX_BOARDSIZE, and the moves have the semantics of Blackout::applyMove.
+ */
+class MultiBoard
+{
+ private:
+  /**
+   * The bit planes: the bit of lane l of plane[i] is the cell of index i of board l, that is the bit i of its state.
+   */
+  uint64_t plane[MAX_BOARDSIZE*MAX_BOARDSIZE][MULTIBOARD_WORDS];
+  /**
+   * The plane with the bits of the boards in use set.
+   */
+  uint64_t active[MULTIBOARD_WORDS];
+  /**
+   * The length of the side of the boards.
+   */
+  int boardSize;
+  /**
+   * Number of boards.
+   */
+  int nBoards;
+  /**
+   * For every cell, the cells flipped by a move at that cell.
+   */
+  int moveCell[MAX_BOARDSIZE*MAX_BOARDSIZE][5];
+  /**
+   * For every cell, the number of cells flipped by a move at that cell.
+   */
+  int moveSize[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  /**
+   * Set if the planes are handled with AVX2, checked once when the boards are built.
+   */
+  bool avx2;
+
+ public:
+  /**
+   * Constructor that creates boards with all cells set to 0.
+   * @param sideLength The side of the boards, limited to the range [1, MAX_BOARDSIZE].
+   * @param boards Number of boards, limited to the range [1, MAX_MULTIBOARD_BOARDS].
+   */
+  MultiBoard (int sideLength, int boards=MAX_MULTIBOARD_BOARDS);
+  /**
+   * Returns the number of boards.
+   */
+  int getBoardCount ();
+  /**
+   * Returns the length of the side of the boards.
+   */
+  int getSize ();
+  /**
+   * Sets the state of one board, one bit per cell as in Board::getState. The return value is false if there is no such board.
+   * @param lane The board, from 0.
+   * @param state The new state of the board.
+   */
+  bool setBoard (int lane, uint64_t state);
+  /**
+   * Returns the state of one board, one bit per cell as in Board::getState, or 0 if there is no such board.
+   * @param lane The board, from 0.
+   */
+  uint64_t getBoard (int lane);
+  /**
+   * Sets the states of all boards, one bit per cell as in Board::getState.
+   * @param states The states, one per board, getBoardCount() in all.
+   */
+  void setBoards (const uint64_t *states);
+  /**
+   * Carries out the move at (x, y) on every board. If the co-ordinates are valid, the return is true, else false.
+   * @param x Row number of the point where the move is carried out.
+   * @param y Column number of the point where the move is carried out.
+   */
+  bool applyMove (int x, int y);
+  /**
+   * Carries out the move at (x, y) on the boards whose bits are set in lanes. If the co-ordinates are valid, the return is true, else false.
+   * @param x Row number of the point where the move is carried out.
+   * @param y Column number of the point where the move is carried out.
+   * @param lanes Plane of MULTIBOARD_WORDS words with the bits of the boards to play set.
+   */
+  bool applyMove (int x, int y, const uint64_t *lanes);
+  /**
+   * Presses on every board the cells of its own press set, for instance the solution found for it by the Solver.
+   * @param presses The press sets, one per board as in Solver::solve, getBoardCount() in all.
+   */
+  void applyPresses (const uint64_t *presses);
+  /**
+   * Checks the win condition of every board: the bit of a board is set in wins if all its cells are 0 or all are 1. The return value is the number of boards won.
+   * @param wins Plane of MULTIBOARD_WORDS words where the bits of the boards won are set.
+   */
+  int checkWins (uint64_t *wins);
+  /**
+   * Counts the lit cells of every board with bitsliced counters: each plane is added to a binary counter whose bits are themselves planes, so the cells of all boards are added at once.
+   * @param counts The number of cells of value 1 of each board, getBoardCount() in all.
+   */
+  void countLitCells (int *counts);
+};
+
+#endif
@@ -0,0 +1,248 @@
+/**
+ *@file neighbourhood.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class Neighbourhood.
+ *@details The Neighbourhood class describes the cells flipped by a move, the rule of a variant of the game.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "neighbourhood.h"
+
+/**
+ * Offsets of the plus shaped stencil.
+ */
+static const int plusOffsets[][2] = { {0, 0}, {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+/**
+ * Offsets of the king stencil.
+ */
+static const int kingOffsets[][2] = { {0, 0}, {-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1} };
+/**
+ * Offsets of the knight stencil.
+ */
+static const int knightOffsets[][2] = { {0, 0}, {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1} };
+
+/**
+ * Constructor that sets up one of the built in rules. RULE_CUSTOM starts with no offsets.
+ * @param neighbourhoodRule The rule. Default value: RULE_PLUS.
+ */
+Neighbourhood::Neighbourhood (NeighbourhoodRule neighbourhoodRule)
+{
+  const int (*offsets)[2] = NULL;
+  int i, n = 0;
+
+  switch (neighbourhoodRule)
+    {
+    case RULE_PLUS:
+    case RULE_TORUS:
+      offsets = plusOffsets;
+      n = sizeof (plusOffsets) / sizeof (plusOffsets[0]);
+      break;
+    case RULE_KING:
+      offsets = kingOffsets;
+      n = sizeof (kingOffsets) / sizeof (kingOffsets[0]);
+      break;
+    case RULE_KNIGHT:
+      offsets = knightOffsets;
+      n = sizeof (knightOffsets) / sizeof (knightOffsets[0]);
+      break;
+    default:
+      neighbourhoodRule = RULE_CUSTOM;
+      break;
+    }
+
+  this->nOffsets = n;
+  for (i=0; i<n; i++)
+    {
+      this->rowOffset[i] = offsets[i][0];
+      this->columnOffset[i] = offsets[i][1];
+    }
+  this->wrap = (neighbourhoodRule == RULE_TORUS);
+  this->rule = neighbourhoodRule;
+}
+
+/**
+ * Adds the cell at the given offset from the pressed cell to the stencil, which becomes a custom rule. The return value is false if the stencil is full, already holds the offset, or the offset is beyond MAX_NEIGHBOURHOOD_REACH rows or columns, which would reach past the largest packed board or, wrapped around, alias a nearer offset.
+ * @param rows Offset in rows, positive downwards.
+ * @param columns Offset in columns, positive to the right.
+ */
+bool Neighbourhood::addOffset (int rows, int columns)
+{
+  int i;
+
+  if (this->nOffsets >= MAX_NEIGHBOURHOOD_OFFSETS || abs (rows) > MAX_NEIGHBOURHOOD_REACH || abs (columns) > MAX_NEIGHBOURHOOD_REACH)
+    {
+      return (false);
+    }
+  for (i=0; i<this->nOffsets; i++)
+    {
+      if (this->rowOffset[i] == rows && this->columnOffset[i] == columns)
+	{
+	  return (false);
+	}
+    }
+
+  this->rowOffset[this->nOffsets] = rows;
+  this->columnOffset[this->nOffsets] = columns;
+  (this->nOffsets)++;
+  this->rule = RULE_CUSTOM;
+  return (true);
+}
+
+/**
+ * Sets whether the offsets wrap around the edges of the board. The stencil becomes a custom rule.
+ * @param wrapAround True for a board whose edges wrap around.
+ */
+void Neighbourhood::setWrap (bool wrapAround)
+{
+  this->wrap = wrapAround;
+  this->rule = RULE_CUSTOM;
+}
+
+/**
+ * Sets the stencil from a text: the name of a built in rule (plus, torus, king or knight), or a custom list of offsets "rows,columns" separated by semicolons, with a leading @ if the edges wrap around, such as "0,0;1,1;-1,-1". The return value is false if the text is not understood or holds an offset refused by addOffset, in which case the stencil is unchanged.
+ * @param text The text.
+ */
+bool Neighbourhood::parse (const char *text)
+{
+  static const char *names[] = { "plus", "torus", "king", "knight" };
+  static const NeighbourhoodRule rules[] = { RULE_PLUS, RULE_TORUS, RULE_KING, RULE_KNIGHT };
+  Neighbourhood custom (RULE_CUSTOM);
+  int i, rows, columns, length;
+
+  for (i=0; i<4; i++)
+    {
+      if (strcmp (text, names[i]) == 0)
+	{
+	  *this = Neighbourhood (rules[i]);
+	  return (true);
+	}
+    }
+
+  if (*text == '@')
+    {
+      custom.setWrap (true);
+      text++;
+    }
+  while (*text)
+    {
+      if (sscanf (text, "%d,%d%n", &rows, &columns, &length) != 2 || !custom.addOffset (rows, columns))
+	{
+	  return (false);
+	}
+      text += length;
+      if (*text == ';')
+	{
+	  text++;
+	}
+      else if (*text)
+	{
+	  return (false);
+	}
+    }
+  if (custom.nOffsets == 0)
+    {
+      return (false);
+    }
+
+  *this = custom;
+  return (true);
+}
+
+/**
+ * Returns the mask of the cells flipped by a move at the cell of the given index on a packed board of side boardSize. The cell (x, y) is the bit (x-1)*boardSize + (y-1). Offsets that land on the same cell, as on a small wrapped board, cancel out, as two presses of that cell would.
+ * @param boardSize The side of the board, at most MAX_BOARDSIZE.
+ * @param index Index of the pressed cell.
+ */
+uint64_t Neighbourhood::moveMask (int boardSize, int index) const
+{
+  int row = index / boardSize;
+  int column = index % boardSize;
+  int i, r, c;
+  uint64_t mask = 0;
+
+  for (i=0; i<this->nOffsets; i++)
+    {
+      r = row + this->rowOffset[i];
+      c = column + this->columnOffset[i];
+      if (this->wrap)
+	{
+	  r = ((r % boardSize) + boardSize) % boardSize;
+	  c = ((c % boardSize) + boardSize) % boardSize;
+	}
+      else if (r < 0 || r >= boardSize || c < 0 || c >= boardSize)
+	{
+	  continue;
+	}
+      // On a small wrapped board two offsets can land on the same cell: it is flipped twice, which leaves it unchanged
+      mask ^= ((uint64_t) 1) << (r*boardSize + c);
+    }
+
+  return (mask);
+}
+
+/**
+ * Returns the rule.
+ */
+NeighbourhoodRule Neighbourhood::getRule () const
+{
+  return (this->rule);
+}
+
+/**
+ * Returns true for the rule of the classic game, the only one for which the lights can be chased row by row and the only one of large boards.
+ */
+bool Neighbourhood::isPlus () const
+{
+  return (this->rule == RULE_PLUS);
+}
+
+/**
+ * Returns a text that identifies the stencil, in the format read by parse.
+ */
+std::string Neighbourhood::getName () const
+{
+  static const char *names[] = { "plus", "torus", "king", "knight" };
+  std::string name;
+  char offset[32];
+  int i;
+
+  if (this->rule != RULE_CUSTOM)
+    {
+      return (names[this->rule]);
+    }
+
+  if (this->wrap)
+    {
+      name = "@";
+    }
+  for (i=0; i<this->nOffsets; i++)
+    {
+      snprintf (offset, sizeof (offset), "%s%d,%d", i ? ";" : "", this->rowOffset[i], this->columnOffset[i]);
+      name += offset;
+    }
+  return (name);
+}
@@ -0,0 +1,145 @@
+/**
+ *@file neighbourhood.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class Neighbourhood.
+ *@details The Neighbourhood class describes the cells flipped by a move, the rule of a variant of the game.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NEIGHBOURHOOD_H
+#define NEIGHBOURHOOD_H
+
+#include <stdint.h>
+#include <string>
+
+/**
+ * The largest number of cells in a neighbourhood, the pressed cell included.
+ */
+#ifndef MAX_NEIGHBOURHOOD_OFFSETS
+#define MAX_NEIGHBOURHOOD_OFFSETS 64
+#endif
+
+/**
+ * The largest offset, in rows or columns, of a cell of a stencil: one less than MAX_BOARDSIZE, the side of the largest packed board.
+ */
+#ifndef MAX_NEIGHBOURHOOD_REACH
+#define MAX_NEIGHBOURHOOD_REACH 7
+#endif
+
+/**
+ * The rules of the game: which cells a move at a cell flips.
+ */
+enum NeighbourhoodRule
+  {
+    /**
+     * The cell and the cells above, below, to the left and to the right of it: the rule of the classic game.
+     */
+    RULE_PLUS,
+    /**
+     * As RULE_PLUS, with the edges of the board wrapping around to the opposite edge.
+     */
+    RULE_TORUS,
+    /**
+     * The cell and the eight cells around it, as a king moves in chess.
+     */
+    RULE_KING,
+    /**
+     * The cell and the eight cells a knight's move away from it.
+     */
+    RULE_KNIGHT,
+    /**
+     * Any set of offsets, given by the user.
+     */
+    RULE_CUSTOM
+  };
+
+/**
+ * The Neighbourhood class is the stencil of a move: the offsets, in rows and columns, of the cells flipped by a move at a cell, and whether the offsets wrap around the edges of the board. It is only used to precompute the move mask of every cell when a packed board is built, so every rule costs the same at move time: one XOR with the mask of the cell.
+ */
+class Neighbourhood
+{
+ private:
+  /**
+   * The rule described.
+   */
+  NeighbourhoodRule rule;
+  /**
+   * Number of offsets in the stencil.
+   */
+  int nOffsets;
+  /**
+   * Row offset of each cell of the stencil.
+   */
+  int rowOffset[MAX_NEIGHBOURHOOD_OFFSETS];
+  /**
+   * Column offset of each cell of the stencil.
+   */
+  int columnOffset[MAX_NEIGHBOURHOOD_OFFSETS];
+  /**
+   * If set, offsets that leave the board come back in on the opposite edge; otherwise they are dropped.
+   */
+  bool wrap;
+
+ public:
+    /**
+     * Constructor that sets up one of the built in rules. RULE_CUSTOM starts with no offsets.
+     * @param neighbourhoodRule The rule. Default value: RULE_PLUS.
+     */
+    Neighbourhood (NeighbourhoodRule neighbourhoodRule=RULE_PLUS);
+    /**
+     * Adds the cell at the given offset from the pressed cell to the stencil, which becomes a custom rule. The return value is false if the stencil is full, already holds the offset, or the offset is beyond MAX_NEIGHBOURHOOD_REACH rows or columns, which would reach past the largest packed board or, wrapped around, alias a nearer offset.
+     * @param rows Offset in rows, positive downwards.
+     * @param columns Offset in columns, positive to the right.
+     */
+    bool addOffset (int rows, int columns);
+    /**
+     * Sets whether the offsets wrap around the edges of the board. The stencil becomes a custom rule.
+     * @param wrapAround True for a board whose edges wrap around.
+     */
+    void setWrap (bool wrapAround);
+    /**
+     * Sets the stencil from a text: the name of a built in rule (plus, torus, king or knight), or a custom list of offsets "rows,columns" separated by semicolons, with a leading @ if the edges wrap around, such as "0,0;1,1;-1,-1". The return value is false if the text is not understood or holds an offset refused by addOffset, in which case the stencil is unchanged.
+     * @param text The text.
+     */
+    bool parse (const char *text);
+    /**
+     * Returns the mask of the cells flipped by a move at the cell of the given index on a packed board of side boardSize. The cell (x, y) is the bit (x-1)*boardSize + (y-1). Offsets that land on the same cell, as on a small wrapped board, cancel out, as two presses of that cell would.
+     * @param boardSize The side of the board, at most MAX_BOARDSIZE.
+     * @param index Index of the pressed cell.
+     */
+    uint64_t moveMask (int boardSize, int index) const;
+    /**
+     * Returns the rule.
+     */
+    NeighbourhoodRule getRule () const;
+    /**
+     * Returns true for the rule of the classic game, the only one for which the lights can be chased row by row and the only one of large boards.
+     */
+    bool isPlus () const;
+    /**
+     * Returns a text that identifies the stencil, in the format read by parse.
+     */
+    std::string getName () const;
+};
+
+#endif
@@ -0,0 +1,288 @@
+/**
+ *@file puzzleBank.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class PuzzleBank.
+ *@details The PuzzleBank class gives access to a file of pregenerated puzzles mapped into memory.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "puzzleBank.h"
+
+/**
+ * Constructor of an empty bank.
+ */
+PuzzleBank::PuzzleBank ()
+{
+  int i;
+
+  this->data = NULL;
+  this->size = 0;
+  this->nSections = 0;
+  for (i=0; i<=MAX_BOARDSIZE; i++)
+    {
+      this->section[i] = 0;
+    }
+}
+
+/**
+ * Destructor that unmaps the file.
+ */
+PuzzleBank::~PuzzleBank ()
+{
+  this->close ();
+}
+
+/**
+ * Maps the puzzle bank file with the given name into memory. Only the header and the section table are read. The return value is false if the file cannot be mapped or is not a valid puzzle bank.
+ * @param fileName Name of the puzzle bank file.
+ */
+bool PuzzleBank::open (const char *fileName)
+{
+  struct stat fileStatus;
+  void *mapped;
+  int fd;
+
+  this->close ();
+
+  fd = ::open (fileName, O_RDONLY);
+  if (fd < 0)
+    {
+      return (false);
+    }
+  if (fstat (fd, &fileStatus) != 0 || fileStatus.st_size < PUZZLE_BANK_HEADER_SIZE)
+    {
+      ::close (fd);
+      return (false);
+    }
+
+  // A shared read-only mapping: the pages are shared by every process that opens the bank
+  mapped = mmap (NULL, (size_t) fileStatus.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close (fd);
+  if (mapped == MAP_FAILED)
+    {
+      return (false);
+    }
+
+  this->data = (const unsigned char *) mapped;
+  this->size = (size_t) fileStatus.st_size;
+  if (!this->readIndex ())
+    {
+      this->close ();
+      return (false);
+    }
+  return (true);
+}
+
+/**
+ * Unmaps the file.
+ */
+void PuzzleBank::close ()
+{
+  int i;
+
+  if (this->data)
+    {
+      munmap ((void *) this->data, this->size);
+    }
+  this->data = NULL;
+  this->size = 0;
+  this->nSections = 0;
+  for (i=0; i<=MAX_BOARDSIZE; i++)
+    {
+      this->section[i] = 0;
+    }
+}
+
+/**
+ * Checks the header and the section table of the mapped file and fills section. The return value is false if the file is not a valid puzzle bank.
+ */
+bool PuzzleBank::readIndex ()
+{
+  unsigned char header[PUZZLE_BANK_HEADER_SIZE];
+  const unsigned char *entry;
+  size_t tableEnd, offset;
+  uint64_t count, indexOffset, puzzleOffset;
+  uint32_t checksum;
+  int i, boardSize, maxDifficulty;
+
+  for (i=0; i<4; i++)
+    {
+      if (this->data[i] != (unsigned char) PUZZLE_BANK_MAGIC[i])
+	{
+	  return (false);
+	}
+    }
+  if (this->data[4] != PUZZLE_BANK_VERSION)
+    {
+      return (false);
+    }
+
+  this->nSections = this->data[5];
+  tableEnd = PUZZLE_BANK_HEADER_SIZE + (size_t) this->nSections * PUZZLE_BANK_SECTION_SIZE;
+  if (tableEnd > this->size)
+    {
+      return (false);
+    }
+
+  // The checksum covers the header, with the checksum itself set to 0, and the section table
+  for (i=0; i<PUZZLE_BANK_HEADER_SIZE; i++)
+    {
+      header[i] = this->data[i];
+    }
+  checksum = (uint32_t) loadLittleEndian (header + 8, 4);
+  storeLittleEndian (header + 8, 0, 4);
+  if (checksum != checksum32 (this->data + PUZZLE_BANK_HEADER_SIZE, tableEnd - PUZZLE_BANK_HEADER_SIZE, checksum32 (header, PUZZLE_BANK_HEADER_SIZE)))
+    {
+      return (false);
+    }
+
+  for (i=0; i<this->nSections; i++)
+    {
+      offset = PUZZLE_BANK_HEADER_SIZE + (size_t) i * PUZZLE_BANK_SECTION_SIZE;
+      entry = this->data + offset;
+      boardSize = entry[0];
+      maxDifficulty = entry[1];
+      count = loadLittleEndian (entry + 8, 8);
+      indexOffset = loadLittleEndian (entry + 16, 8);
+      puzzleOffset = loadLittleEndian (entry + 24, 8);
+
+      // Every section must lie within the file
+      if (boardSize < 1 || boardSize > MAX_BOARDSIZE || this->section[boardSize] != 0)
+	{
+	  return (false);
+	}
+      if (indexOffset > this->size || (this->size - indexOffset) / 8 < (uint64_t) maxDifficulty + 2)
+	{
+	  return (false);
+	}
+      if (puzzleOffset > this->size || (this->size - puzzleOffset) / 8 < count)
+	{
+	  return (false);
+	}
+      if (loadLittleEndian (this->data + indexOffset + 8*((size_t) maxDifficulty + 1), 8) != count)
+	{
+	  return (false);
+	}
+      this->section[boardSize] = offset;
+    }
+
+  return (true);
+}
+
+/**
+ * Returns the number of puzzles of the given board size.
+ * @param boardSize The side of the square board.
+ */
+uint64_t PuzzleBank::getPuzzleCount (int boardSize)
+{
+  if (boardSize < 1 || boardSize > MAX_BOARDSIZE || this->section[boardSize] == 0)
+    {
+      return (0);
+    }
+  return (loadLittleEndian (this->data + this->section[boardSize] + 8, 8));
+}
+
+/**
+ * Returns the largest difficulty of the puzzles of the given board size, or -1 if there are none.
+ * @param boardSize The side of the square board.
+ */
+int PuzzleBank::getMaxDifficulty (int boardSize)
+{
+  if (boardSize < 1 || boardSize > MAX_BOARDSIZE || this->section[boardSize] == 0)
+    {
+      return (-1);
+    }
+  return (this->data[this->section[boardSize] + 1]);
+}
+
+/**
+ * Copies the state of the puzzle with the given id and board size to state. The return value is false if there is no such puzzle.
+ * @param boardSize The side of the square board.
+ * @param id The id of the puzzle, in [0, getPuzzleCount(boardSize)).
+ * @param state Pointer to the location where the state of the puzzle is copied.
+ */
+bool PuzzleBank::getPuzzle (int boardSize, uint64_t id, uint64_t *state)
+{
+  uint64_t puzzleOffset;
+
+  if (id >= this->getPuzzleCount (boardSize))
+    {
+      return (false);
+    }
+  puzzleOffset = loadLittleEndian (this->data + this->section[boardSize] + 24, 8);
+  *state = loadLittleEndian (this->data + puzzleOffset + 8*id, 8);
+  return (true);
+}
+
+/**
+ * Finds the puzzles of the given board size and difficulty: their ids are first, first+1, ..., first+count-1. The return value is false if the bank has no puzzle of that size.
+ * @param boardSize The side of the square board.
+ * @param difficulty The fewest moves needed to solve the puzzles.
+ * @param first Pointer to the location where the id of the first puzzle is copied.
+ * @param count Pointer to the location where the number of puzzles is copied.
+ */
+bool PuzzleBank::getDifficultyRange (int boardSize, int difficulty, uint64_t *first, uint64_t *count)
+{
+  const unsigned char *index;
+  uint64_t next;
+  int maxDifficulty = this->getMaxDifficulty (boardSize);
+
+  if (maxDifficulty < 0)
+    {
+      return (false);
+    }
+  if (difficulty < 0 || difficulty > maxDifficulty)
+    {
+      *first = 0;
+      *count = 0;
+      return (true);
+    }
+
+  index = this->data + loadLittleEndian (this->data + this->section[boardSize] + 16, 8);
+  *first = loadLittleEndian (index + 8*difficulty, 8);
+  next = loadLittleEndian (index + 8*(difficulty+1), 8);
+  *count = (next > *first) ? next - *first : 0;
+  return (true);
+}
+
+/**
+ * Copies the state of a random puzzle of the given board size and difficulty to state. The return value is false if there is no such puzzle.
+ * @param boardSize The side of the square board.
+ * @param difficulty The fewest moves needed to solve the puzzle.
+ * @param state Pointer to the location where the state of the puzzle is copied.
+ */
+bool PuzzleBank::getRandomPuzzle (int boardSize, int difficulty, uint64_t *state)
+{
+  uint64_t first, count;
+
+  if (!this->getDifficultyRange (boardSize, difficulty, &first, &count) || count == 0)
+    {
+      return (false);
+    }
+  return (this->getPuzzle (boardSize, first + getThreadRandomGenerator ()->nextBounded (count), state));
+}
@@ -0,0 +1,151 @@
+/**
+ *@file puzzleBank.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class PuzzleBank.
+ *@details The PuzzleBank class gives access to a file of pregenerated puzzles mapped into memory.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PUZZLEBANK_H
+#define PUZZLEBANK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "tools.h"
+#include "board.h"
+
+/**
+ * The puzzle bank file starts with these 4 bytes.
+ */
+#ifndef PUZZLE_BANK_MAGIC
+#define PUZZLE_BANK_MAGIC "BKB\x1A"
+#endif
+
+/**
+ * Version of the puzzle bank format.
+ */
+#ifndef PUZZLE_BANK_VERSION
+#define PUZZLE_BANK_VERSION 1
+#endif
+
+/**
+ * Size in bytes of the header of a puzzle bank file.
+ */
+#ifndef PUZZLE_BANK_HEADER_SIZE
+#define PUZZLE_BANK_HEADER_SIZE 16
+#endif
+
+/**
+ * Size in bytes of an entry of the section table of a puzzle bank file.
+ */
+#ifndef PUZZLE_BANK_SECTION_SIZE
+#define PUZZLE_BANK_SECTION_SIZE 32
+#endif
+
+/**
+ * The PuzzleBank class maps a puzzle bank file read-only into memory, so that it is shared by every process using it and only the pages that are touched are read from disk. Any puzzle, or the range of puzzles of a given difficulty, is found in constant time without parsing the file.
+ * The file is little-endian and laid out as follows.
+ * Header, PUZZLE_BANK_HEADER_SIZE bytes: bytes 0-3: PUZZLE_BANK_MAGIC, byte 4: PUZZLE_BANK_VERSION, byte 5: number of sections, bytes 6-7: 0, bytes 8-11: checksum32 of the header and the section table with these bytes set to 0, bytes 12-15: 0.
+ * Section table, one entry of PUZZLE_BANK_SECTION_SIZE bytes per board size: byte 0: board size, byte 1: largest difficulty D, bytes 2-7: 0, bytes 8-15: number of puzzles, bytes 16-23: file offset of the difficulty index, bytes 24-31: file offset of the puzzles.
+ * Difficulty index of a section: D+2 64-bit puzzle ids, entry d being the id of the first puzzle of difficulty d and entry D+1 the number of puzzles.
+ * Puzzles of a section: one 64-bit state per puzzle, cell (x, y) in bit (x-1)*size + (y-1), sorted by difficulty, the fewest moves needed to solve them.
+ */
+class PuzzleBank
+{
+ private:
+  /**
+   * The file mapped into memory, or NULL if no bank is open.
+   */
+  const unsigned char *data;
+  /**
+   * Size of the mapped file in bytes.
+   */
+  size_t size;
+  /**
+   * Number of sections in the bank.
+   */
+  int nSections;
+  /**
+   * For each board size, the offset of its entry in the section table, or 0 if the bank has no puzzle of that size.
+   */
+  size_t section[MAX_BOARDSIZE+1];
+
+  /**
+   * Checks the header and the section table of the mapped file and fills section. The return value is false if the file is not a valid puzzle bank.
+   */
+  bool readIndex ();
+
+ public:
+  /**
+   * Constructor of an empty bank.
+   */
+  PuzzleBank ();
+  /**
+   * Destructor that unmaps the file.
+   */
+  ~PuzzleBank ();
+  /**
+   * Maps the puzzle bank file with the given name into memory. Only the header and the section table are read. The return value is false if the file cannot be mapped or is not a valid puzzle bank.
+   * @param fileName Name of the puzzle bank file.
+   */
+  bool open (const char *fileName);
+  /**
+   * Unmaps the file.
+   */
+  void close ();
+  /**
+   * Returns the number of puzzles of the given board size.
+   * @param boardSize The side of the square board.
+   */
+  uint64_t getPuzzleCount (int boardSize);
+  /**
+   * Returns the largest difficulty of the puzzles of the given board size, or -1 if there are none.
+   * @param boardSize The side of the square board.
+   */
+  int getMaxDifficulty (int boardSize);
+  /**
+   * Copies the state of the puzzle with the given id and board size to state. The return value is false if there is no such puzzle.
+   * @param boardSize The side of the square board.
+   * @param id The id of the puzzle, in [0, getPuzzleCount(boardSize)).
+   * @param state Pointer to the location where the state of the puzzle is copied.
+   */
+  bool getPuzzle (int boardSize, uint64_t id, uint64_t *state);
+  /**
+   * Finds the puzzles of the given board size and difficulty: their ids are first, first+1, ..., first+count-1. The return value is false if the bank has no puzzle of that size.
+   * @param boardSize The side of the square board.
+   * @param difficulty The fewest moves needed to solve the puzzles.
+   * @param first Pointer to the location where the id of the first puzzle is copied.
+   * @param count Pointer to the location where the number of puzzles is copied.
+   */
+  bool getDifficultyRange (int boardSize, int difficulty, uint64_t *first, uint64_t *count);
+  /**
+   * Copies the state of a random puzzle of the given board size and difficulty to state. The return value is false if there is no such puzzle.
+   * @param boardSize The side of the square board.
+   * @param difficulty The fewest moves needed to solve the puzzle.
+   * @param state Pointer to the location where the state of the puzzle is copied.
+   */
+  bool getRandomPuzzle (int boardSize, int difficulty, uint64_t *state);
+};
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ *@file puzzleBankWriter.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class PuzzleBankWriter.
+ *@details The PuzzleBankWriter class collects puzzles and writes them to a puzzle bank file.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+
+#include "puzzleBankWriter.h"
+
+/**
+ * Adds a puzzle to the bank. The return value is false if the board size or the difficulty is out of range.
+ * @param boardSize The side of the square board.
+ * @param state The state of the puzzle, cell (x, y) in bit (x-1)*boardSize + (y-1).
+ * @param difficulty The fewest moves needed to solve the puzzle, at most boardSize*boardSize.
+ */
+bool PuzzleBankWriter::addPuzzle (int boardSize, uint64_t state, int difficulty)
+{
+  if (boardSize < 1 || boardSize > MAX_BOARDSIZE || difficulty < 0 || difficulty > boardSize*boardSize)
+    {
+      return (false);
+    }
+  this->puzzles[boardSize].push_back (state);
+  this->difficulties[boardSize].push_back ((unsigned char) difficulty);
+  return (true);
+}
+
+/**
+ * Writes the puzzles added so far to the file with the given name. The return value is false if the file cannot be written.
+ * @param fileName Name of the puzzle bank file.
+ */
+bool PuzzleBankWriter::write (const char *fileName)
+{
+  unsigned char header[PUZZLE_BANK_HEADER_SIZE];
+  std::vector<unsigned char> table;
+  std::vector<unsigned char> block;
+  std::vector<uint64_t> start;
+  int maxDifficulty[MAX_BOARDSIZE+1];
+  uint64_t offset, count;
+  uint32_t checksum;
+  int size, d, nSections = 0;
+  size_t i, entry;
+  FILE *outFile;
+  bool written = true;
+
+  // The sections follow the header and the section table
+  for (size=1; size<=MAX_BOARDSIZE; size++)
+    {
+      if (!this->puzzles[size].empty ())
+	{
+	  nSections++;
+	}
+    }
+  offset = PUZZLE_BANK_HEADER_SIZE + (uint64_t) nSections * PUZZLE_BANK_SECTION_SIZE;
+  table.assign ((size_t) nSections * PUZZLE_BANK_SECTION_SIZE, 0);
+
+  entry = 0;
+  for (size=1; size<=MAX_BOARDSIZE; size++)
+    {
+      if (this->puzzles[size].empty ())
+	{
+	  continue;
+	}
+      maxDifficulty[size] = 0;
+      for (i=0; i<this->difficulties[size].size (); i++)
+	{
+	  if (this->difficulties[size][i] > maxDifficulty[size])
+	    {
+	      maxDifficulty[size] = this->difficulties[size][i];
+	    }
+	}
+      count = this->puzzles[size].size ();
+      table[entry] = (unsigned char) size;
+      table[entry+1] = (unsigned char) maxDifficulty[size];
+      storeLittleEndian (&table[entry+8], count, 8);
+      storeLittleEndian (&table[entry+16], offset, 8);
+      offset += 8 * ((uint64_t) maxDifficulty[size] + 2);
+      storeLittleEndian (&table[entry+24], offset, 8);
+      offset += 8 * count;
+      entry += PUZZLE_BANK_SECTION_SIZE;
+    }
+
+  for (i=0; i<PUZZLE_BANK_HEADER_SIZE; i++)
+    {
+      header[i] = 0;
+    }
+  for (i=0; i<4; i++)
+    {
+      header[i] = (unsigned char) PUZZLE_BANK_MAGIC[i];
+    }
+  header[4] = PUZZLE_BANK_VERSION;
+  header[5] = (unsigned char) nSections;
+  checksum = checksum32 (header, PUZZLE_BANK_HEADER_SIZE);
+  if (!table.empty ())
+    {
+      checksum = checksum32 (&table[0], table.size (), checksum);
+    }
+  storeLittleEndian (header + 8, checksum, 4);
+
+  outFile = fopen (fileName, "wb");
+  if (!outFile)
+    {
+      return (false);
+    }
+  written = fwrite (header, 1, PUZZLE_BANK_HEADER_SIZE, outFile) == PUZZLE_BANK_HEADER_SIZE;
+  if (written && !table.empty ())
+    {
+      written = fwrite (&table[0], 1, table.size (), outFile) == table.size ();
+    }
+
+  for (size=1; written && size<=MAX_BOARDSIZE; size++)
+    {
+      if (this->puzzles[size].empty ())
+	{
+	  continue;
+	}
+      count = this->puzzles[size].size ();
+
+      // Counting sort: start[d] is the id of the first puzzle of difficulty d
+      start.assign (maxDifficulty[size] + 2, 0);
+      for (i=0; i<count; i++)
+	{
+	  start[this->difficulties[size][i] + 1]++;
+	}
+      for (d=1; d<=maxDifficulty[size]+1; d++)
+	{
+	  start[d] += start[d-1];
+	}
+
+      block.assign (8 * (start.size () + count), 0);
+      for (d=0; d<=maxDifficulty[size]+1; d++)
+	{
+	  storeLittleEndian (&block[8*d], start[d], 8);
+	}
+      // The puzzles of each difficulty keep the order in which they were added
+      for (i=0; i<count; i++)
+	{
+	  d = this->difficulties[size][i];
+	  storeLittleEndian (&block[8 * (maxDifficulty[size] + 2 + start[d])], this->puzzles[size][i], 8);
+	  start[d]++;
+	}
+      written = fwrite (&block[0], 1, block.size (), outFile) == block.size ();
+    }
+
+  if (fclose (outFile) != 0)
+    {
+      written = false;
+    }
+  return (written);
+}
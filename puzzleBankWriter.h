@@ -0,0 +1,67 @@
+/**
+ *@file puzzleBankWriter.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class PuzzleBankWriter.
+ *@details The PuzzleBankWriter class collects puzzles and writes them to a puzzle bank file.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PUZZLEBANKWRITER_H
+#define PUZZLEBANKWRITER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "puzzleBank.h"
+
+/**
+ * The PuzzleBankWriter class collects puzzles of any board size, with their difficulty, and writes them to a file in the format read by the PuzzleBank class. The puzzles of each size are sorted by difficulty with a counting sort when the file is written.
+ */
+class PuzzleBankWriter
+{
+ private:
+  /**
+   * The states of the puzzles, for each board size.
+   */
+  std::vector<uint64_t> puzzles[MAX_BOARDSIZE+1];
+  /**
+   * The difficulties of the puzzles, for each board size.
+   */
+  std::vector<unsigned char> difficulties[MAX_BOARDSIZE+1];
+
+ public:
+  /**
+   * Adds a puzzle to the bank. The return value is false if the board size or the difficulty is out of range.
+   * @param boardSize The side of the square board.
+   * @param state The state of the puzzle, cell (x, y) in bit (x-1)*boardSize + (y-1).
+   * @param difficulty The fewest moves needed to solve the puzzle, at most boardSize*boardSize.
+   */
+  bool addPuzzle (int boardSize, uint64_t state, int difficulty);
+  /**
+   * Writes the puzzles added so far to the file with the given name. The return value is false if the file cannot be written.
+   * @param fileName Name of the puzzle bank file.
+   */
+  bool write (const char *fileName);
+};
+
+#endif
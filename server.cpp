@@ -0,0 +1,520 @@
+/**
+ *@file server.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class BlackoutServer.
+ *@details The BlackoutServer class serves puzzles and solutions to other processes over a Unix domain socket.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <inttypes.h>
+#include <string.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <algorithm>
+
+#include "server.h"
+
+/**
+ * Writes all of data to a socket. The return value is false if the connection is closed.
+ * @param fd The socket.
+ * @param data The bytes to write.
+ */
+static bool writeAll (int fd, const std::string &data)
+{
+  size_t written = 0;
+  ssize_t n;
+
+  while (written < data.size ())
+    {
+      n = send (fd, data.data () + written, data.size () - written, MSG_NOSIGNAL);
+      if (n <= 0)
+	{
+	  return (false);
+	}
+      written += (size_t) n;
+    }
+  return (true);
+}
+
+/**
+ * Returns whether nothing but blanks follows position start of a request.
+ * @param request The request.
+ * @param start Position in the request.
+ */
+static bool atEnd (const std::string &request, int start)
+{
+  return (request.find_first_not_of (" \t", (size_t) start) == std::string::npos);
+}
+
+/**
+ * Constructor that sets the parameters of the server.
+ * @param path Path of the socket.
+ * @param threads Number of worker threads. If 0, one per available core.
+ */
+BlackoutServer::BlackoutServer (const char *path, int threads)
+{
+  int i;
+
+  this->socketPath = path;
+  this->nThreads = threads;
+  if (this->nThreads <= 0)
+    {
+      this->nThreads = (int) std::thread::hardware_concurrency ();
+    }
+  if (this->nThreads <= 0)
+    {
+      this->nThreads = 1;
+    }
+  this->listenFd = -1;
+  this->running.store (false);
+  this->stopWorkers = false;
+  this->nRequests.store (0);
+  this->nErrors.store (0);
+  this->latency = new std::atomic<uint32_t>[SERVER_LATENCY_SAMPLES];
+  for (i=0; i<SERVER_LATENCY_SAMPLES; i++)
+    {
+      this->latency[i].store (0);
+    }
+  this->startTime = Instrumentation::now ();
+}
+
+/**
+ * Destructor that closes the socket.
+ */
+BlackoutServer::~BlackoutServer ()
+{
+  size_t i;
+
+  // The workers are still running if run was never called
+  {
+    std::lock_guard<std::mutex> lock (this->queueMutex);
+    this->stopWorkers = true;
+  }
+  this->queueFilled.notify_all ();
+  for (i=0; i<this->workers.size (); i++)
+    {
+      this->workers[i].join ();
+    }
+  if (this->listenFd >= 0)
+    {
+      close (this->listenFd);
+      unlink (this->socketPath.c_str ());
+    }
+  delete[] (this->latency);
+  this->latency = NULL;
+}
+
+/**
+ * Creates the socket and starts listening. A file left at the path of the socket is replaced. The return value is false if the socket cannot be created.
+ */
+bool BlackoutServer::start ()
+{
+  struct sockaddr_un address;
+  int i;
+
+  if (this->socketPath.size () >= sizeof (address.sun_path))
+    {
+      return (false);
+    }
+  memset (&address, 0, sizeof (address));
+  address.sun_family = AF_UNIX;
+  strcpy (address.sun_path, this->socketPath.c_str ());
+
+  this->listenFd = socket (AF_UNIX, SOCK_STREAM, 0);
+  if (this->listenFd < 0)
+    {
+      return (false);
+    }
+  unlink (this->socketPath.c_str ());
+  if (bind (this->listenFd, (struct sockaddr *) &address, sizeof (address)) != 0 || listen (this->listenFd, SOMAXCONN) != 0)
+    {
+      close (this->listenFd);
+      this->listenFd = -1;
+      return (false);
+    }
+
+  this->startTime = Instrumentation::now ();
+  this->running.store (true);
+  for (i=0; i<this->nThreads; i++)
+    {
+      this->workers.push_back (std::thread (&BlackoutServer::work, this));
+    }
+  return (true);
+}
+
+/**
+ * Accepts and serves connections until stop is called, then closes every connection and stops the workers.
+ */
+void BlackoutServer::run ()
+{
+  struct pollfd listening;
+  size_t i;
+  int fd;
+
+  listening.fd = this->listenFd;
+  listening.events = POLLIN;
+  while (this->running.load ())
+    {
+      // The wait is bounded so that a call to stop is noticed
+      if (poll (&listening, 1, SERVER_POLL_MILLISECONDS) <= 0)
+	{
+	  continue;
+	}
+      fd = accept (this->listenFd, NULL, NULL);
+      if (fd < 0)
+	{
+	  continue;
+	}
+      {
+	std::lock_guard<std::mutex> lock (this->connectionMutex);
+	this->connections.push_back (fd);
+      }
+      std::thread (&BlackoutServer::serveConnection, this, fd).detach ();
+    }
+
+  close (this->listenFd);
+  this->listenFd = -1;
+  unlink (this->socketPath.c_str ());
+
+  // Wake up the connections blocked in a read, and wait for them to finish their batches
+  {
+    std::unique_lock<std::mutex> lock (this->connectionMutex);
+    for (i=0; i<this->connections.size (); i++)
+      {
+	shutdown (this->connections[i], SHUT_RDWR);
+      }
+    this->connectionClosed.wait (lock, [this] { return this->connections.empty (); });
+  }
+
+  {
+    std::lock_guard<std::mutex> lock (this->queueMutex);
+    this->stopWorkers = true;
+  }
+  this->queueFilled.notify_all ();
+  for (i=0; i<this->workers.size (); i++)
+    {
+      this->workers[i].join ();
+    }
+  this->workers.clear ();
+}
+
+/**
+ * Asks the server to stop. It is safe to call from a signal handler.
+ */
+void BlackoutServer::stop ()
+{
+  this->running.store (false);
+}
+
+/**
+ * Reads the requests of a connection in batches and writes their responses, until the connection is closed.
+ * @param fd The socket of the connection.
+ */
+void BlackoutServer::serveConnection (int fd)
+{
+  char buffer[4096];
+  std::string pending, output;
+  ServerBatch batch;
+  size_t start, end, i;
+  ssize_t n;
+  bool open = true;
+
+  while (open)
+    {
+      n = recv (fd, buffer, sizeof (buffer), 0);
+      if (n <= 0)
+	{
+	  break;
+	}
+      pending.append (buffer, (size_t) n);
+
+      // Every complete line received so far is answered, in batches of at most SERVER_MAX_BATCH lines
+      start = 0;
+      end = pending.find ('\n');
+      while (open && end != std::string::npos)
+	{
+	  batch.requests.clear ();
+	  while (end != std::string::npos && batch.requests.size () < SERVER_MAX_BATCH)
+	    {
+	      batch.requests.push_back (pending.substr (start, (end > start && pending[end-1] == '\r') ? end - start - 1 : end - start));
+	      start = end + 1;
+	      end = pending.find ('\n', start);
+	    }
+	  this->submit (&batch);
+
+	  output.clear ();
+	  for (i=0; i<batch.responses.size (); i++)
+	    {
+	      output += batch.responses[i];
+	      output += '\n';
+	    }
+	  open = writeAll (fd, output);
+	}
+      pending.erase (0, start);
+
+      if (open && pending.size () > SERVER_MAX_LINE)
+	{
+	  writeAll (fd, "ERR request too long\n");
+	  open = false;
+	}
+    }
+
+  close (fd);
+  {
+    std::lock_guard<std::mutex> lock (this->connectionMutex);
+    this->connections.erase (std::find (this->connections.begin (), this->connections.end (), fd));
+  }
+  this->connectionClosed.notify_all ();
+}
+
+/**
+ * Adds a batch to the queue, waiting while the queue is full, and waits until a worker has answered it.
+ * @param batch The batch.
+ */
+void BlackoutServer::submit (ServerBatch *batch)
+{
+  std::unique_lock<std::mutex> lock (this->queueMutex);
+
+  // The time spent waiting for room in the queue counts in the latency
+  batch->received = Instrumentation::now ();
+  batch->done = false;
+  this->queueDrained.wait (lock, [this] { return this->queue.size () < SERVER_QUEUE_SIZE; });
+  this->queue.push_back (batch);
+  this->queueFilled.notify_one ();
+  this->batchDone.wait (lock, [batch] { return batch->done; });
+}
+
+/**
+ * Takes batches from the queue and answers them until the workers are stopped.
+ */
+void BlackoutServer::work ()
+{
+  Blackout *games[MAX_GAMESQUARESIZE+1];
+  ServerBatch *batch;
+  uint64_t index;
+  size_t i;
+  int size;
+
+  for (size=0; size<=MAX_GAMESQUARESIZE; size++)
+    {
+      games[size] = NULL;
+    }
+
+  for (;;)
+    {
+      {
+	std::unique_lock<std::mutex> lock (this->queueMutex);
+	this->queueFilled.wait (lock, [this] { return this->stopWorkers || !this->queue.empty (); });
+	if (this->queue.empty ())
+	  {
+	    break;
+	  }
+	batch = this->queue.front ();
+	this->queue.pop_front ();
+      }
+      this->queueDrained.notify_one ();
+
+      batch->responses.resize (batch->requests.size ());
+      for (i=0; i<batch->requests.size (); i++)
+	{
+	  batch->responses[i] = this->answer (batch->requests[i], games);
+	  if (batch->responses[i].compare (0, 3, "ERR") == 0)
+	    {
+	      this->nErrors.fetch_add (1);
+	    }
+	  index = this->nRequests.fetch_add (1);
+	  this->latency[index % SERVER_LATENCY_SAMPLES].store ((uint32_t) ((Instrumentation::now () - batch->received) / 1000), std::memory_order_relaxed);
+	}
+
+      {
+	std::lock_guard<std::mutex> lock (this->queueMutex);
+	batch->done = true;
+      }
+      this->batchDone.notify_all ();
+    }
+
+  for (size=0; size<=MAX_GAMESQUARESIZE; size++)
+    {
+      delete (games[size]);
+    }
+}
+
+/**
+ * Returns the response to a request line.
+ * @param request The request, without its end of line.
+ * @param games One game per board size, created as they are needed, in which the request is worked out.
+ */
+std::string BlackoutServer::answer (const std::string &request, Blackout **games)
+{
+  char command[16], response[64];
+  int size, minMoves, maxMoves, moves, attempt, fields, consumed = 0;
+  uint64_t state = 0, presses = 0;
+  Blackout *game;
+
+  if (sscanf (request.c_str (), "%15s%n", command, &consumed) != 1)
+    {
+      return ("ERR empty request");
+    }
+  if (strcmp (command, "STATS") == 0)
+    {
+      return (this->getStats ());
+    }
+
+  // Every other request starts with the board size, followed by a state except for GENERATE
+  if (strcmp (command, "GENERATE") == 0)
+    {
+      fields = sscanf (request.c_str (), "%*s %d %d %d%n", &size, &minMoves, &maxMoves, &consumed);
+      if (fields == 1)
+	{
+	  sscanf (request.c_str (), "%*s %d%n", &size, &consumed);
+	  minMoves = 0;
+	  maxMoves = MAX_GAMESQUARESIZE*MAX_GAMESQUARESIZE;
+	}
+      else if (fields != 3)
+	{
+	  return ("ERR usage: GENERATE size [minMoves maxMoves]");
+	}
+    }
+  else if (strcmp (command, "SOLVE") == 0 || strcmp (command, "RATE") == 0)
+    {
+      if (sscanf (request.c_str (), "%*s %d %" SCNx64 "%n", &size, &state, &consumed) != 2)
+	{
+	  return (std::string ("ERR usage: ") + command + " size state");
+	}
+    }
+  else if (strcmp (command, "VALIDATE") == 0)
+    {
+      if (sscanf (request.c_str (), "%*s %d %" SCNx64 " %" SCNx64 "%n", &size, &state, &presses, &consumed) != 3)
+	{
+	  return ("ERR usage: VALIDATE size state presses");
+	}
+    }
+  else
+    {
+      return ("ERR unknown request");
+    }
+  if (!atEnd (request, consumed))
+    {
+      return ("ERR trailing data");
+    }
+  if (size < 1 || size > MAX_GAMESQUARESIZE)
+    {
+      return ("ERR board size out of range");
+    }
+
+  if (!games[size])
+    {
+      games[size] = new Blackout (size);
+    }
+  game = games[size];
+  if (size < 8 && ((state | presses) >> (size*size)) != 0)
+    {
+      return ("ERR cells outside the board");
+    }
+
+  if (command[0] == 'G')
+    {
+      if (size < SERVER_MIN_GENERATE_SIZE)
+	{
+	  return ("ERR board size out of range");
+	}
+      for (attempt=0; attempt<SERVER_GENERATE_ATTEMPTS; attempt++)
+	{
+	  if (!game->generateGame ())
+	    {
+	      continue;
+	    }
+	  moves = game->getOptimalMoves ();
+	  if (moves >= minMoves && moves <= maxMoves)
+	    {
+	      snprintf (response, sizeof (response), "OK %016" PRIx64 " %d", game->getInitialState (), moves);
+	      return (response);
+	    }
+	}
+      return ("ERR no puzzle found within the difficulty band");
+    }
+
+  game->newGame (state);
+  if (command[0] == 'S')
+    {
+      if (!game->solve (&presses, SOLVE_OPTIMAL))
+	{
+	  return ("ERR unsolvable");
+	}
+      snprintf (response, sizeof (response), "OK %016" PRIx64 " %d", presses, popCount (presses));
+      return (response);
+    }
+  if (command[0] == 'R')
+    {
+      moves = game->getOptimalMoves ();
+      if (moves < 0)
+	{
+	  return ("ERR unsolvable");
+	}
+      snprintf (response, sizeof (response), "OK %d", moves);
+      return (response);
+    }
+  return (game->isSolution (&presses) ? "OK 1" : "OK 0");
+}
+
+/**
+ * Returns the response to STATS.
+ */
+std::string BlackoutServer::getStats ()
+{
+  std::vector<uint32_t> samples;
+  uint64_t requests = this->nRequests.load ();
+  uint64_t i, n = (requests < SERVER_LATENCY_SAMPLES) ? requests : SERVER_LATENCY_SAMPLES;
+  double uptime = (Instrumentation::now () - this->startTime) / 1e9;
+  uint32_t p50 = 0, p99 = 0;
+  size_t queued, open;
+  char response[256];
+
+  // The percentiles are taken over the most recent requests
+  samples.resize ((size_t) n);
+  for (i=0; i<n; i++)
+    {
+      samples[i] = this->latency[i].load (std::memory_order_relaxed);
+    }
+  if (n > 0)
+    {
+      std::nth_element (samples.begin (), samples.begin () + (n * 50) / 100, samples.end ());
+      p50 = samples[(n * 50) / 100];
+      std::nth_element (samples.begin (), samples.begin () + (n * 99) / 100, samples.end ());
+      p99 = samples[(n * 99) / 100];
+    }
+  {
+    std::lock_guard<std::mutex> lock (this->queueMutex);
+    queued = this->queue.size ();
+  }
+  {
+    std::lock_guard<std::mutex> lock (this->connectionMutex);
+    open = this->connections.size ();
+  }
+
+  snprintf (response, sizeof (response), "OK requests=%" PRIu64 " errors=%" PRIu64 " uptime_s=%.3f throughput=%.1f p50_us=%u p99_us=%u queued=%u connections=%u workers=%d",
+	    requests, this->nErrors.load (), uptime, uptime > 0 ? requests / uptime : 0.0, p50, p99, (unsigned) queued, (unsigned) open, this->nThreads);
+  return (response);
+}
@@ -0,0 +1,251 @@
+/**
+ *@file server.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class BlackoutServer.
+ *@details The BlackoutServer class serves puzzles and solutions to other processes over a Unix domain socket.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "blackout.h"
+
+/**
+ * Largest number of requests of a connection handled together as one batch.
+ */
+#ifndef SERVER_MAX_BATCH
+#define SERVER_MAX_BATCH 256
+#endif
+
+/**
+ * Largest number of batches waiting for a worker. A connection whose batch does not fit waits, and stops reading its socket, until a worker takes one.
+ */
+#ifndef SERVER_QUEUE_SIZE
+#define SERVER_QUEUE_SIZE 1024
+#endif
+
+/**
+ * Longest request line, in bytes. A connection that sends a longer line is closed.
+ */
+#ifndef SERVER_MAX_LINE
+#define SERVER_MAX_LINE 256
+#endif
+
+/**
+ * Number of latencies of the most recent requests kept for the percentiles of STATS.
+ */
+#ifndef SERVER_LATENCY_SAMPLES
+#define SERVER_LATENCY_SAMPLES 65536
+#endif
+
+/**
+ * Number of states drawn by GENERATE before giving up on the difficulty band.
+ */
+#ifndef SERVER_GENERATE_ATTEMPTS
+#define SERVER_GENERATE_ATTEMPTS 100000
+#endif
+
+/**
+ * The smallest board size of GENERATE. Every state of a 1x1 board is already won, so no puzzle can be drawn for it.
+ */
+#ifndef SERVER_MIN_GENERATE_SIZE
+#define SERVER_MIN_GENERATE_SIZE 2
+#endif
+
+/**
+ * Interval, in milliseconds, at which the server checks whether it was asked to stop.
+ */
+#ifndef SERVER_POLL_MILLISECONDS
+#define SERVER_POLL_MILLISECONDS 200
+#endif
+
+/**
+ * Requests of one connection read together, and their responses.
+ */
+struct ServerBatch
+{
+  /**
+   * The request lines.
+   */
+  std::vector<std::string> requests;
+  /**
+   * The response lines, one per request, filled by a worker.
+   */
+  std::vector<std::string> responses;
+  /**
+   * The time at which the batch was read, in nanoseconds as given by Instrumentation::now().
+   */
+  uint64_t received;
+  /**
+   * Set by the worker once every response is filled.
+   */
+  bool done;
+};
+
+/**
+ * The BlackoutServer class serves requests over a Unix domain socket, with a line-delimited protocol. Each request is one line and is answered by one line starting with OK or ERR, in the order of the requests of the connection:
+ * GENERATE size [minMoves maxMoves]: a random puzzle, whose fewest moves are within the band if one is given, on a board of size at least SERVER_MIN_GENERATE_SIZE. Response: OK state moves.
+ * SOLVE size state: the fewest presses that solve the state. Response: OK presses moves.
+ * RATE size state: the fewest moves needed to solve the state. Response: OK moves.
+ * VALIDATE size state presses: whether the presses solve the state. Response: OK 1 or OK 0.
+ * STATS: the number of requests and errors, the uptime, the throughput and the 50th and 99th percentiles of the latency. Response: OK name=value ...
+ * States and presses are in hexadecimal with the cell (x, y) in the bit (x-1)*size + (y-1), as in the packs of BatchGenerator, and sizes are within 1-MAX_GAMESQUARESIZE.
+ * Each connection is read by its own thread, which passes the requests it has received to a pool of workers as one batch and writes the responses of the batch in one go. The queue of batches is bounded: when it is full, connections stop reading until the workers catch up, so a client that sends faster than the server can answer is slowed down by its socket rather than queued without bound.
+ */
+class BlackoutServer
+{
+ private:
+  /**
+   * Path of the socket.
+   */
+  std::string socketPath;
+  /**
+   * Number of worker threads.
+   */
+  int nThreads;
+  /**
+   * The listening socket, or -1.
+   */
+  int listenFd;
+  /**
+   * Cleared to stop the server.
+   */
+  std::atomic<bool> running;
+  /**
+   * Set once every connection is closed, to stop the workers.
+   */
+  bool stopWorkers;
+  /**
+   * The worker threads.
+   */
+  std::vector<std::thread> workers;
+  /**
+   * The batches waiting for a worker.
+   */
+  std::deque<ServerBatch *> queue;
+  /**
+   * Guards the queue, stopWorkers and the done flags of the batches.
+   */
+  std::mutex queueMutex;
+  /**
+   * Signalled when a batch is added to the queue, or the workers are stopped.
+   */
+  std::condition_variable queueFilled;
+  /**
+   * Signalled when a batch is taken from the queue.
+   */
+  std::condition_variable queueDrained;
+  /**
+   * Signalled when a batch is done.
+   */
+  std::condition_variable batchDone;
+  /**
+   * The sockets of the open connections.
+   */
+  std::vector<int> connections;
+  /**
+   * Guards connections.
+   */
+  std::mutex connectionMutex;
+  /**
+   * Signalled when a connection is closed.
+   */
+  std::condition_variable connectionClosed;
+  /**
+   * Number of requests answered.
+   */
+  std::atomic<uint64_t> nRequests;
+  /**
+   * Number of requests answered with ERR.
+   */
+  std::atomic<uint64_t> nErrors;
+  /**
+   * Latencies of the most recent requests, in microseconds, from the time their batch was read to the time they were answered.
+   */
+  std::atomic<uint32_t> *latency;
+  /**
+   * The time at which the server started, in nanoseconds as given by Instrumentation::now().
+   */
+  uint64_t startTime;
+
+  /**
+   * Takes batches from the queue and answers them until the workers are stopped.
+   */
+  void work ();
+  /**
+   * Reads the requests of a connection in batches and writes their responses, until the connection is closed.
+   * @param fd The socket of the connection.
+   */
+  void serveConnection (int fd);
+  /**
+   * Adds a batch to the queue, waiting while the queue is full, and waits until a worker has answered it.
+   * @param batch The batch.
+   */
+  void submit (ServerBatch *batch);
+  /**
+   * Returns the response to a request line.
+   * @param request The request, without its end of line.
+   * @param games One game per board size, created as they are needed, in which the request is worked out.
+   */
+  std::string answer (const std::string &request, Blackout **games);
+  /**
+   * Returns the response to STATS.
+   */
+  std::string getStats ();
+
+ public:
+  /**
+   * Constructor that sets the parameters of the server.
+   * @param path Path of the socket.
+   * @param threads Number of worker threads. If 0, one per available core.
+   */
+  BlackoutServer (const char *path, int threads=0);
+  /**
+   * Destructor that closes the socket.
+   */
+  ~BlackoutServer ();
+  /**
+   * Creates the socket and starts listening. A file left at the path of the socket is replaced. The return value is false if the socket cannot be created.
+   */
+  bool start ();
+  /**
+   * Accepts and serves connections until stop is called, then closes every connection and stops the workers.
+   */
+  void run ();
+  /**
+   * Asks the server to stop. It is safe to call from a signal handler.
+   */
+  void stop ();
+};
+
+#endif
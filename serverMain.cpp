@@ -0,0 +1,80 @@
+/**
+ *@file serverMain.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief Command line tool that serves puzzles and solutions over a Unix domain socket.
+ *@details Runs a BlackoutServer on the given socket until it receives SIGINT or SIGTERM.
+ *Usage: blackout_server socketPath [threads]
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <signal.h>
+
+#include "server.h"
+
+/**
+ * The server stopped by the signal handler.
+ */
+static BlackoutServer *server = NULL;
+
+/**
+ * Stops the server on SIGINT and SIGTERM.
+ * @param signalNumber The signal received.
+ */
+static void stopServer (int signalNumber)
+{
+  (void) signalNumber;
+  if (server)
+    {
+      server->stop ();
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  int threads = 0;
+
+  if (argc < 2)
+    {
+      std::cerr << "Usage: " << argv[0] << " socketPath [threads]\n";
+      return (1);
+    }
+  if (argc > 2)
+    {
+      threads = atoi (argv[2]);
+    }
+
+  BlackoutServer blackoutServer (argv[1], threads);
+  if (!blackoutServer.start ())
+    {
+      std::cerr << "Cannot listen on " << argv[1] << "\n";
+      return (1);
+    }
+  server = &blackoutServer;
+  signal (SIGINT, stopServer);
+  signal (SIGTERM, stopServer);
+
+  blackoutServer.run ();
+  server = NULL;
+  return (0);
+}
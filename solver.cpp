@@ -0,0 +1,565 @@
+/**
+ *@file solver.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class Solver.
+ *@details The Solver class finds the moves that solve a given state of the board.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "solver.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+ * Constructor that builds the press matrix from the move masks of the board.
+ * @param board The board whose moves are to be solved.
+ */
+Solver::Solver (Board *board)
+{
+  this->initialize (board);
+}
+
+/**
+ * Constructor that builds the press matrix for a board of the given size.
+ * @param sideLength The side of the square board.
+ */
+Solver::Solver (int sideLength)
+{
+  Board board (sideLength);
+  this->initialize (&board);
+}
+
+/**
+ * Returns the shared solver of the given board size, or NULL if the size is not within [1, MAX_BOARDSIZE]. The solvers of all sizes, with their tables, are built once on the first call and reused by every game.
+ * @param sideLength The side of the square board.
+ */
+Solver *Solver::forSize (int sideLength)
+{
+  static Solver *solvers[MAX_BOARDSIZE+1];
+  static bool built = Solver::buildAll (solvers);
+
+  if (!built || sideLength < 1 || sideLength > MAX_BOARDSIZE)
+    {
+      return (NULL);
+    }
+  return (solvers[sideLength]);
+}
+
+/**
+ * Returns the shared solver of the given board size under the given rule, or NULL if the size is not within [1, MAX_BOARDSIZE]. The plus rule is served by forSize; the solver of any other rule is built on the first call for that size and rule and reused by every game. The call is thread-safe.
+ * @param sideLength The side of the square board.
+ * @param rule The cells flipped by a move.
+ */
+Solver *Solver::forNeighbourhood (int sideLength, const Neighbourhood &rule)
+{
+  static std::mutex lock;
+  static std::map<std::string, Solver *> solvers;
+
+  if (rule.isPlus () || sideLength < 1 || sideLength > MAX_BOARDSIZE)
+    {
+      return (Solver::forSize (sideLength));
+    }
+
+  std::string key = std::to_string (sideLength) + " " + rule.getName ();
+  std::lock_guard<std::mutex> guard (lock);
+  std::map<std::string, Solver *>::iterator found = solvers.find (key);
+  if (found != solvers.end ())
+    {
+      return (found->second);
+    }
+
+  Board board (sideLength, rule);
+  Solver *solver = new Solver (&board);
+  solvers[key] = solver;
+  return (solver);
+}
+
+/**
+ * Builds the press matrix from the move masks of the board and the light chasing table.
+ * @param board The board whose moves are to be solved.
+ */
+void Solver::initialize (Board *board)
+{
+  int i, j;
+  uint64_t mask, residue, presses;
+
+  this->boardSize = board->getSize ();
+  this->nCells = this->boardSize * this->boardSize;
+  this->boardMask = board->getBoardMask ();
+  this->rowMask = (((uint64_t) 1) << this->boardSize) - 1;
+  this->chaseable = board->getNeighbourhood ().isPlus ();
+
+  for (i=0; i<MAX_BOARDSIZE*MAX_BOARDSIZE; i++)
+    {
+      this->pressMatrix[i] = 0;
+      this->inverse[i] = 0;
+      this->inconsistency[i] = 0;
+    }
+
+  // Column j of the matrix is the move mask of cell j
+  for (j=0; j<this->nCells; j++)
+    {
+      mask = board->getMoveMask (j);
+      for (i=0; i<this->nCells; i++)
+	{
+	  if ((mask >> i) & 1)
+	    {
+	      this->pressMatrix[i] |= ((uint64_t) 1) << j;
+	    }
+	}
+    }
+
+  this->findQuietPatterns ();
+
+  for (i=0; i<(1 << MAX_BOARDSIZE); i++)
+    {
+      this->chaseTable[i] = -1;
+    }
+  if (!this->chaseable)
+    {
+      this->findInverse ();
+      return;
+    }
+
+  // Chase every first row pattern on an empty board and note the residue it leaves in the bottom row.
+  // Chasing is linear, so the first row that clears a board is the one whose residue equals the board's own.
+  for (i=0; i<(1 << this->boardSize); i++)
+    {
+      presses = 0;
+      residue = this->chase (this->pressRow (0, 0, (uint64_t) i), &presses);
+      residue >>= (this->boardSize - 1) * this->boardSize;
+      if (this->chaseTable[residue] < 0)
+	{
+	  this->chaseTable[residue] = i;
+	}
+    }
+}
+
+/**
+ * Reduces the press matrix to reduced row echelon form and stores a basis of its null space in quietPattern.
+ */
+void Solver::findQuietPatterns ()
+{
+  uint64_t row[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  int pivotColumn[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  uint64_t t;
+  int i, r, c;
+  int rank = 0;
+
+  for (i=0; i<this->nCells; i++)
+    {
+      row[i] = this->pressMatrix[i];
+    }
+
+  this->nQuietPatterns = 0;
+  for (c=0; c<this->nCells; c++)
+    {
+      for (i=rank; i<this->nCells; i++)
+	{
+	  if ((row[i] >> c) & 1)
+	    {
+	      break;
+	    }
+	}
+      if (i == this->nCells)
+	{
+	  // Free column: setting it, and the pivots of the rows that contain it, gives a quiet pattern
+	  t = ((uint64_t) 1) << c;
+	  for (r=0; r<rank; r++)
+	    {
+	      if ((row[r] >> c) & 1)
+		{
+		  t |= ((uint64_t) 1) << pivotColumn[r];
+		}
+	    }
+	  this->quietPattern[this->nQuietPatterns] = t;
+	  (this->nQuietPatterns)++;
+	  continue;
+	}
+
+      t = row[i];
+      row[i] = row[rank];
+      row[rank] = t;
+      for (r=0; r<this->nCells; r++)
+	{
+	  if (r != rank && ((row[r] >> c) & 1))
+	    {
+	      row[r] ^= row[rank];
+	    }
+	}
+      pivotColumn[rank] = c;
+      rank++;
+    }
+}
+
+/**
+ * Reduces the press matrix together with the identity and stores the inverse and inconsistency tables, used to solve a board whose lights cannot be chased.
+ */
+void Solver::findInverse ()
+{
+  uint64_t row[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  uint64_t operations[MAX_BOARDSIZE*MAX_BOARDSIZE];   // Bit j of operations[i] is set if the original row j was added into row i
+  int pivotColumn[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  uint64_t t;
+  int i, r, c;
+  int rank = 0;
+
+  for (i=0; i<this->nCells; i++)
+    {
+      row[i] = this->pressMatrix[i];
+      operations[i] = ((uint64_t) 1) << i;
+    }
+
+  for (c=0; c<this->nCells && rank<this->nCells; c++)
+    {
+      for (i=rank; i<this->nCells; i++)
+	{
+	  if ((row[i] >> c) & 1)
+	    {
+	      break;
+	    }
+	}
+      if (i == this->nCells)
+	{
+	  continue;
+	}
+
+      if (i != rank)
+	{
+	  t = row[i];
+	  row[i] = row[rank];
+	  row[rank] = t;
+	  t = operations[i];
+	  operations[i] = operations[rank];
+	  operations[rank] = t;
+	}
+      for (r=0; r<this->nCells; r++)
+	{
+	  if (r != rank && ((row[r] >> c) & 1))
+	    {
+	      row[r] ^= row[rank];
+	      operations[r] ^= operations[rank];
+	    }
+	}
+      pivotColumn[rank] = c;
+      rank++;
+    }
+
+  // The reduced right hand side of row r is the parity of the lit cells in operations[r]; sort those by lit cell
+  for (r=0; r<this->nCells; r++)
+    {
+      for (i=0; i<this->nCells; i++)
+	{
+	  if ((operations[r] >> i) & 1)
+	    {
+	      if (r < rank)
+		{
+		  this->inverse[i] ^= ((uint64_t) 1) << pivotColumn[r];
+		}
+	      else
+		{
+		  this->inconsistency[i] ^= ((uint64_t) 1) << r;
+		}
+	    }
+	}
+    }
+}
+
+/**
+ * Presses the cells given by the bits of pattern in row number row (counted from 0) of state, and returns the new state.
+ * @param state The state of the board.
+ * @param row The row in which the cells are pressed, counted from 0.
+ * @param pattern The columns pressed, bit j for column j+1.
+ */
+uint64_t Solver::pressRow (uint64_t state, int row, uint64_t pattern)
+{
+  int shift = row * this->boardSize;
+  uint64_t presses = pattern << shift;
+
+  // The pressed cells and their left and right neighbours within the row
+  state ^= ((pattern ^ (pattern << 1) ^ (pattern >> 1)) & this->rowMask) << shift;
+  // The cells above and below
+  state ^= (presses >> this->boardSize) ^ (presses << this->boardSize);
+
+  return (state & this->boardMask);
+}
+
+/**
+ * Chases the lights of state down the board: every lit cell is switched off by pressing the cell below it, row after row. The presses are added to the set pointed to by presses and the final state, in which only the bottom row may be lit, is returned.
+ * @param state The state of the board.
+ * @param presses Pointer to the set of presses, to which the chasing presses are added.
+ */
+uint64_t Solver::chase (uint64_t state, uint64_t *presses)
+{
+  int row;
+  uint64_t lit;
+
+  for (row=0; row<this->boardSize-1; row++)
+    {
+      lit = (state >> (row * this->boardSize)) & this->rowMask;
+      state = this->pressRow (state, row+1, lit);
+      *presses ^= lit << ((row+1) * this->boardSize);
+    }
+
+  return (state);
+}
+
+/**
+ * Finds a set of presses that turns the given state into the empty board, by Gaussian elimination of the system Ap = state over GF(2). Each row of the system is one 64-bit word, so eliminating a row is a single XOR. The return value is false if the state cannot be cleared.
+ * @param state The state of the board to be cleared.
+ * @param presses Pointer to the location where the set of presses is copied.
+ */
+bool Solver::solveGaussian (uint64_t state, uint64_t *presses)
+{
+  uint64_t row[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  int pivotColumn[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  uint64_t rhs = state & this->boardMask;   // Bit i is the right hand side of row i
+  uint64_t t, bitI, bitR;
+  int i, r, c;
+  int rank = 0;
+
+  for (i=0; i<this->nCells; i++)
+    {
+      row[i] = this->pressMatrix[i];
+    }
+
+  // Reduce the augmented system to reduced row echelon form
+  for (c=0; c<this->nCells && rank<this->nCells; c++)
+    {
+      // Find a pivot for column c
+      for (i=rank; i<this->nCells; i++)
+	{
+	  if ((row[i] >> c) & 1)
+	    {
+	      break;
+	    }
+	}
+      if (i == this->nCells)
+	{
+	  // Free column
+	  continue;
+	}
+
+      // Move the pivot row into place
+      if (i != rank)
+	{
+	  t = row[i];
+	  row[i] = row[rank];
+	  row[rank] = t;
+	  bitI = (rhs >> i) & 1;
+	  bitR = (rhs >> rank) & 1;
+	  if (bitI != bitR)
+	    {
+	      rhs ^= (((uint64_t) 1) << i) | (((uint64_t) 1) << rank);
+	    }
+	}
+
+      // Clear column c from every other row
+      for (r=0; r<this->nCells; r++)
+	{
+	  if (r != rank && ((row[r] >> c) & 1))
+	    {
+	      row[r] ^= row[rank];
+	      rhs ^= ((rhs >> rank) & 1) << r;
+	    }
+	}
+
+      pivotColumn[rank] = c;
+      rank++;
+    }
+
+  // Rows without a pivot read 0 = rhs, so the system is consistent only if those are all 0
+  for (i=rank; i<this->nCells; i++)
+    {
+      if ((rhs >> i) & 1)
+	{
+	  return (false);
+	}
+    }
+
+  // Free variables are set to 0, each pivot variable takes the value of its row
+  *presses = 0;
+  for (i=0; i<rank; i++)
+    {
+      *presses |= ((rhs >> i) & 1) << pivotColumn[i];
+    }
+
+  return (true);
+}
+
+/**
+ * Finds a set of presses that turns the given state into the empty board by chasing the lights: the lights are chased to the bottom row, the first row presses that clear the remaining residue are looked up in the chase table, and the lights are chased again with those presses. A board whose lights cannot be chased is solved from the inverse tables instead. The return value is false if the state cannot be cleared.
+ * @param state The state of the board to be cleared.
+ * @param presses Pointer to the location where the set of presses is copied.
+ */
+bool Solver::solveChase (uint64_t state, uint64_t *presses)
+{
+  uint64_t chasePresses = 0;
+  uint64_t residue;
+  int firstRow;
+
+  if (!this->chaseable)
+    {
+      return (this->solveInverse (state, presses));
+    }
+  state &= this->boardMask;
+  residue = this->chase (state, &chasePresses) >> ((this->boardSize - 1) * this->boardSize);
+  firstRow = this->chaseTable[residue];
+  if (firstRow < 0)
+    {
+      return (false);
+    }
+
+  *presses = (uint64_t) firstRow;
+  this->chase (this->pressRow (state, 0, (uint64_t) firstRow), presses);
+  return (true);
+}
+
+/**
+ * Finds a set of presses that turns the given state into the empty board from the inverse tables, with one XOR per lit cell. The return value is false if the state cannot be cleared.
+ * @param state The state of the board to be cleared.
+ * @param presses Pointer to the location where the set of presses is copied.
+ */
+bool Solver::solveInverse (uint64_t state, uint64_t *presses)
+{
+  uint64_t solution = 0, check = 0;
+  int index;
+
+  for (state&=this->boardMask; state; state&=state-1)
+    {
+      index = popCount ((state & (~state + 1)) - 1);
+      solution ^= this->inverse[index];
+      check ^= this->inconsistency[index];
+    }
+  if (check)
+    {
+      return (false);
+    }
+
+  *presses = solution;
+  return (true);
+}
+
+/**
+ * Finds a set of presses with the fewest cells that turns the given state into the empty board. All solutions are one solution plus a combination of quiet patterns, so the combinations are enumerated in Gray code order, each step costing one XOR and one popcount. Past SOLVER_MAX_QUIET_PATTERNS quiet patterns, which only some custom rules reach, the search would not end in reasonable time, and the solution of solveChase is returned as it is. The return value is false if the state cannot be cleared.
+ * @param state The state of the board to be cleared.
+ * @param presses Pointer to the location where the set of presses is copied.
+ */
+bool Solver::solveOptimal (uint64_t state, uint64_t *presses)
+{
+  uint64_t current, best;
+  int count, bestCount;
+  uint64_t i, nCombinations;
+
+  if (!this->solveChase (state, &current))
+    {
+      return (false);
+    }
+  if (this->nQuietPatterns > SOLVER_MAX_QUIET_PATTERNS)
+    {
+      *presses = current;
+      return (true);
+    }
+
+  best = current;
+  bestCount = popCount (current);
+  nCombinations = ((uint64_t) 1) << this->nQuietPatterns;
+  for (i=1; i<nCombinations; i++)
+    {
+      // Consecutive Gray codes differ in the bit given by the number of trailing zeros of i
+      current ^= this->quietPattern[popCount ((i & (~i + 1)) - 1)];
+      count = popCount (current);
+      if (count < bestCount)
+	{
+	  best = current;
+	  bestCount = count;
+	}
+    }
+
+  *presses = best;
+  return (true);
+}
+
+/**
+ * Finds a set of presses that turns the given state into the empty board with the given method. The return value is false if the state cannot be cleared.
+ * @param state The state of the board to be cleared.
+ * @param presses Pointer to the location where the set of presses is copied.
+ * @param method The method used to solve the board.
+ */
+bool Solver::solve (uint64_t state, uint64_t *presses, SolverMethod method)
+{
+  switch (method)
+    {
+    case SOLVE_GAUSSIAN:
+      return (this->solveGaussian (state, presses));
+    case SOLVE_CHASE:
+      return (this->solveChase (state, presses));
+    case SOLVE_OPTIMAL:
+      return (this->solveOptimal (state, presses));
+    default:
+      return (false);
+    }
+}
+
+/**
+ * Builds the solvers of every board size from 1 to MAX_BOARDSIZE into the array solvers.
+ * @param solvers Array of MAX_BOARDSIZE+1 solvers, indexed by the board size.
+ */
+bool Solver::buildAll (Solver **solvers)
+{
+  int i;
+
+  solvers[0] = NULL;
+  for (i=1; i<=MAX_BOARDSIZE; i++)
+    {
+      solvers[i] = new Solver (i);
+    }
+  return (true);
+}
+
+/**
+ * Returns the mask with one bit set for every cell of the board.
+ */
+uint64_t Solver::getBoardMask ()
+{
+  return (this->boardMask);
+}
+
+/**
+ * Returns the number of quiet patterns in the basis of the null space of the press matrix.
+ */
+int Solver::getQuietPatternCount ()
+{
+  return (this->nQuietPatterns);
+}
+
+/**
+ * Returns the quiet pattern of the basis with the given index.
+ * @param index Index of the quiet pattern, in [0, getQuietPatternCount()).
+ */
+uint64_t Solver::getQuietPattern (int index)
+{
+  return (this->quietPattern[index]);
+}
@@ -0,0 +1,215 @@
+/**
+ *@file solver.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class Solver.
+ *@details The Solver class finds the moves that solve a given state of the board.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <stdint.h>
+
+#include "tools.h"
+#include "board.h"
+
+/**
+ * The largest number of quiet patterns whose combinations are searched for a solution with the fewest presses: 2 to this power combinations.
+ */
+#ifndef SOLVER_MAX_QUIET_PATTERNS
+#define SOLVER_MAX_QUIET_PATTERNS 20
+#endif
+
+/**
+ * The methods available to solve a board.
+ */
+enum SolverMethod
+  {
+    /**
+     * Gaussian elimination of the full press matrix.
+     */
+    SOLVE_GAUSSIAN,
+    /**
+     * Light chasing, completed with the cached first row table of the board size.
+     */
+    SOLVE_CHASE,
+    /**
+     * A solution with the fewest presses, found by searching the quiet patterns of the board size.
+     */
+    SOLVE_OPTIMAL
+  };
+
+/**
+ * The Solver class finds the set of cells to press to clear a board. A move at a cell flips that cell and its neighbours, moves commute and every move is its own inverse, so the effect of a set of presses p on a state s is s XOR Ap, where A is the press matrix over GF(2) whose column j is the move mask of cell j. Solving a board means solving Ap = s.
+ * States and press sets use the bit layout of the Board class: the cell (x, y) is the bit (x-1)*boardSize + (y-1).
+ */
+class Solver
+{
+ private:
+  /**
+   * The length of the side of the square board.
+   */
+  int boardSize;
+  /**
+   * Number of cells on the board, boardSize*boardSize.
+   */
+  int nCells;
+  /**
+   * Mask with one bit set for every cell of the board.
+   */
+  uint64_t boardMask;
+  /**
+   * Rows of the press matrix A: bit j of pressMatrix[i] is set if a move at cell j flips cell i.
+   */
+  uint64_t pressMatrix[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  /**
+   * Mask of the cells in the first row of the board.
+   */
+  uint64_t rowMask;
+  /**
+   * Light chasing table: for every residue left in the bottom row after chasing an empty board, the first row presses that produce it, or -1 if no first row presses do.
+   */
+  int chaseTable[1 << MAX_BOARDSIZE];
+  /**
+   * True if the board follows the plus rule, under which a lit cell is always switched off by the press below it and the lights can be chased. Other rules are solved with the inverse tables.
+   */
+  bool chaseable;
+  /**
+   * For a board whose lights cannot be chased, the presses that clear each single lit cell, up to the quiet patterns, found once by reducing the press matrix. A state is cleared by the XOR of the entries of its lit cells.
+   */
+  uint64_t inverse[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  /**
+   * For a board whose lights cannot be chased, the contribution of each lit cell to the rows of the reduced system left without a pivot. A state can be cleared only if the XOR of the entries of its lit cells is 0.
+   */
+  uint64_t inconsistency[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  /**
+   * Basis of the null space of the press matrix: the quiet patterns, sets of presses that leave every cell unchanged. Adding a quiet pattern to a solution gives another solution.
+   */
+  uint64_t quietPattern[MAX_BOARDSIZE*MAX_BOARDSIZE];
+  /**
+   * Number of quiet patterns in the basis, the dimension of the null space.
+   */
+  int nQuietPatterns;
+
+  /**
+   * Builds the press matrix from the move masks of the board and the light chasing table.
+   * @param board The board whose moves are to be solved.
+   */
+  void initialize (Board *board);
+  /**
+   * Reduces the press matrix to reduced row echelon form and stores a basis of its null space in quietPattern.
+   */
+  void findQuietPatterns ();
+  /**
+   * Reduces the press matrix together with the identity and stores the inverse and inconsistency tables, used to solve a board whose lights cannot be chased.
+   */
+  void findInverse ();
+  /**
+   * Finds a set of presses that turns the given state into the empty board from the inverse tables, with one XOR per lit cell. The return value is false if the state cannot be cleared.
+   * @param state The state of the board to be cleared.
+   * @param presses Pointer to the location where the set of presses is copied.
+   */
+  bool solveInverse (uint64_t state, uint64_t *presses);
+  /**
+   * Presses the cells given by the bits of pattern in row number row (counted from 0) of state, and returns the new state.
+   * @param state The state of the board.
+   * @param row The row in which the cells are pressed, counted from 0.
+   * @param pattern The columns pressed, bit j for column j+1.
+   */
+  uint64_t pressRow (uint64_t state, int row, uint64_t pattern);
+  /**
+   * Chases the lights of state down the board: every lit cell is switched off by pressing the cell below it, row after row. The presses are added to the set pointed to by presses and the final state, in which only the bottom row may be lit, is returned.
+   * @param state The state of the board.
+   * @param presses Pointer to the set of presses, to which the chasing presses are added.
+   */
+  uint64_t chase (uint64_t state, uint64_t *presses);
+  /**
+   * Builds the solvers of every board size from 1 to MAX_BOARDSIZE into the array solvers.
+   * @param solvers Array of MAX_BOARDSIZE+1 solvers, indexed by the board size.
+   */
+  static bool buildAll (Solver **solvers);
+
+ public:
+  /**
+   * Constructor that builds the press matrix from the move masks of the board.
+   * @param board The board whose moves are to be solved.
+   */
+  Solver (Board *board);
+  /**
+   * Constructor that builds the press matrix for a board of the given size.
+   * @param sideLength The side of the square board.
+   */
+  Solver (int sideLength);
+  /**
+   * Returns the shared solver of the given board size, or NULL if the size is not within [1, MAX_BOARDSIZE]. The solvers of all sizes, with their tables, are built once on the first call and reused by every game.
+   * @param sideLength The side of the square board.
+   */
+  static Solver *forSize (int sideLength);
+  /**
+   * Returns the shared solver of the given board size under the given rule, or NULL if the size is not within [1, MAX_BOARDSIZE]. The plus rule is served by forSize; the solver of any other rule is built on the first call for that size and rule and reused by every game. The call is thread-safe.
+   * @param sideLength The side of the square board.
+   * @param rule The cells flipped by a move.
+   */
+  static Solver *forNeighbourhood (int sideLength, const Neighbourhood &rule);
+  /**
+   * Finds a set of presses that turns the given state into the empty board, by Gaussian elimination of the system Ap = state over GF(2). Each row of the system is one 64-bit word, so eliminating a row is a single XOR. The return value is false if the state cannot be cleared.
+   * @param state The state of the board to be cleared.
+   * @param presses Pointer to the location where the set of presses is copied.
+   */
+  bool solveGaussian (uint64_t state, uint64_t *presses);
+  /**
+   * Finds a set of presses that turns the given state into the empty board by chasing the lights: the lights are chased to the bottom row, the first row presses that clear the remaining residue are looked up in the chase table, and the lights are chased again with those presses. A board whose lights cannot be chased is solved from the inverse tables instead. The return value is false if the state cannot be cleared.
+   * @param state The state of the board to be cleared.
+   * @param presses Pointer to the location where the set of presses is copied.
+   */
+  bool solveChase (uint64_t state, uint64_t *presses);
+  /**
+   * Finds a set of presses with the fewest cells that turns the given state into the empty board. All solutions are one solution plus a combination of quiet patterns, so the combinations are enumerated in Gray code order, each step costing one XOR and one popcount. Past SOLVER_MAX_QUIET_PATTERNS quiet patterns, which only some custom rules reach, the search would not end in reasonable time, and the solution of solveChase is returned as it is. The return value is false if the state cannot be cleared.
+   * @param state The state of the board to be cleared.
+   * @param presses Pointer to the location where the set of presses is copied.
+   */
+  bool solveOptimal (uint64_t state, uint64_t *presses);
+  /**
+   * Finds a set of presses that turns the given state into the empty board with the given method. The return value is false if the state cannot be cleared.
+   * @param state The state of the board to be cleared.
+   * @param presses Pointer to the location where the set of presses is copied.
+   * @param method The method used to solve the board.
+   */
+  bool solve (uint64_t state, uint64_t *presses, SolverMethod method);
+  /**
+   * Returns the mask with one bit set for every cell of the board.
+   */
+  uint64_t getBoardMask ();
+  /**
+   * Returns the number of quiet patterns in the basis of the null space of the press matrix.
+   */
+  int getQuietPatternCount ();
+  /**
+   * Returns the quiet pattern of the basis with the given index.
+   * @param index Index of the quiet pattern, in [0, getQuietPatternCount()).
+   */
+  uint64_t getQuietPattern (int index);
+};
+
+#endif
@@ -0,0 +1,184 @@
+/**
+ *@file textReader.cpp
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of member functions of the class TextReader.
+ *@details The TextReader class splits a text file into whitespace separated tokens without allocating memory.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <limits.h>
+
+#include "textReader.h"
+
+/**
+ * Returns whether c is a whitespace character.
+ * @param c The character.
+ */
+static bool isSpace (int c)
+{
+  return (c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f');
+}
+
+/**
+ * Constructor that starts reading the given file, which must be open for reading.
+ * @param inFile The file to be read.
+ */
+TextReader::TextReader (FILE *inFile)
+{
+  this->file = inFile;
+  this->length = 0;
+  this->position = 0;
+  this->token[0] = '\0';
+
+  // Blocks are read straight into this->buffer
+  setvbuf (this->file, NULL, _IONBF, 0);
+}
+
+/**
+ * Returns the next character of the file, or -1 at the end of the file.
+ */
+int TextReader::nextChar ()
+{
+  if (this->position == this->length)
+    {
+      this->length = fread (this->buffer, 1, TEXT_READER_BUFFER_SIZE, this->file);
+      this->position = 0;
+      if (this->length == 0)
+	{
+	  return (-1);
+	}
+    }
+  return ((unsigned char) this->buffer[(this->position)++]);
+}
+
+/**
+ * Reads the next token. The return value is false at the end of the file or if the token is longer than TEXT_READER_TOKEN_SIZE.
+ */
+bool TextReader::nextToken ()
+{
+  int c, n = 0;
+
+  do
+    {
+      c = this->nextChar ();
+    }
+  while (isSpace (c));
+
+  while (c >= 0 && !isSpace (c))
+    {
+      if (n == TEXT_READER_TOKEN_SIZE)
+	{
+	  return (false);
+	}
+      this->token[n++] = (char) c;
+      c = this->nextChar ();
+    }
+  this->token[n] = '\0';
+
+  return (n > 0);
+}
+
+/**
+ * Reads the next token and returns whether it is equal to word.
+ * @param word The expected token.
+ */
+bool TextReader::expect (const char *word)
+{
+  return (this->nextToken () && strcmp (this->token, word) == 0);
+}
+
+/**
+ * Reads the next token as a decimal integer. The return value is false if the token is not an integer or does not fit in an int.
+ * @param value Pointer to the location where the integer is copied.
+ */
+bool TextReader::nextInteger (int *value)
+{
+  long long v = 0;
+  int i = 0;
+  bool negative = false;
+
+  if (!this->nextToken ())
+    {
+      return (false);
+    }
+
+  if (this->token[0] == '-')
+    {
+      negative = true;
+      i++;
+    }
+  if (this->token[i] == '\0')
+    {
+      return (false);
+    }
+  for (; this->token[i] != '\0'; i++)
+    {
+      if (this->token[i] < '0' || this->token[i] > '9')
+	{
+	  return (false);
+	}
+      v = 10*v + (this->token[i] - '0');
+      if (v > INT_MAX)
+	{
+	  return (false);
+	}
+    }
+
+  *value = (int) (negative ? -v : v);
+  return (true);
+}
+
+/**
+ * Reads the next token as a binary digit. The return value is false if the token is not 0 or 1.
+ * @param value Pointer to the location where the digit is copied.
+ */
+bool TextReader::nextBit (int *value)
+{
+  if (!this->nextToken () || this->token[1] != '\0')
+    {
+      return (false);
+    }
+  if (this->token[0] != '0' && this->token[0] != '1')
+    {
+      return (false);
+    }
+  *value = this->token[0] - '0';
+  return (true);
+}
+
+/**
+ * Returns whether only whitespace is left in the file.
+ */
+bool TextReader::atEnd ()
+{
+  int c;
+
+  do
+    {
+      c = this->nextChar ();
+    }
+  while (isSpace (c));
+
+  return (c < 0);
+}
@@ -0,0 +1,111 @@
+/**
+ *@file textReader.h
+ *@author Adhish Majumdar
+ *@version 0.0.0
+ *@date 17/10/2026
+ *@brief File with definition of the class TextReader.
+ *@details The TextReader class splits a text file into whitespace separated tokens without allocating memory.
+ */
+
+/*
+    Blackout
+    Classes and functions to play the game of blackout.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEXTREADER_H
+#define TEXTREADER_H
+
+#include <stdio.h>
+
+/**
+ * Size of the buffer into which the file is read.
+ */
+#ifndef TEXT_READER_BUFFER_SIZE
+#define TEXT_READER_BUFFER_SIZE 4096
+#endif
+
+/**
+ * Longest token that can be read, in characters.
+ */
+#ifndef TEXT_READER_TOKEN_SIZE
+#define TEXT_READER_TOKEN_SIZE 32
+#endif
+
+/**
+ * The TextReader class reads a file in one pass through a fixed buffer that is part of the object, and splits it into whitespace separated tokens. The file is switched to unbuffered mode so that the C library does not allocate a buffer of its own, and each block is read straight into the reader's buffer.
+ */
+class TextReader
+{
+ private:
+  /**
+   * The file being read.
+   */
+  FILE *file;
+  /**
+   * The block of the file being read.
+   */
+  char buffer[TEXT_READER_BUFFER_SIZE];
+  /**
+   * Number of characters in the buffer.
+   */
+  size_t length;
+  /**
+   * Position of the next character in the buffer.
+   */
+  size_t position;
+  /**
+   * The last token read.
+   */
+  char token[TEXT_READER_TOKEN_SIZE+1];
+
+  /**
+   * Returns the next character of the file, or -1 at the end of the file.
+   */
+  int nextChar ();
+
+ public:
+  /**
+   * Constructor that starts reading the given file, which must be open for reading.
+   * @param inFile The file to be read.
+   */
+  TextReader (FILE *inFile);
+  /**
+   * Reads the next token. The return value is false at the end of the file or if the token is longer than TEXT_READER_TOKEN_SIZE.
+   */
+  bool nextToken ();
+  /**
+   * Reads the next token and returns whether it is equal to word.
+   * @param word The expected token.
+   */
+  bool expect (const char *word);
+  /**
+   * Reads the next token as a decimal integer. The return value is false if the token is not an integer or does not fit in an int.
+   * @param value Pointer to the location where the integer is copied.
+   */
+  bool nextInteger (int *value);
+  /**
+   * Reads the next token as a binary digit. The return value is false if the token is not 0 or 1.
+   * @param value Pointer to the location where the digit is copied.
+   */
+  bool nextBit (int *value);
+  /**
+   * Returns whether only whitespace is left in the file.
+   */
+  bool atEnd ();
+};
+
+#endif
@@ -26,26 +26,168 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <random>
+
 #include "tools.h"
 
+#ifdef AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+
+/**
+ * Constructor that seeds the generator with the given seed.
+ * @param seed The seed of the generator.
+ */
+RandomGenerator::RandomGenerator (uint64_t seed)
+{
+  this->seed (seed);
+}
+
+/**
+ * Seeds the generator. The 256 bits of state are expanded from the 64-bit seed by SplitMix64, so that close seeds give unrelated streams.
+ * @param seed The seed of the generator.
+ */
+void RandomGenerator::seed (uint64_t seed)
+{
+  int i;
+
+  for (i=0; i<4; i++)
+    {
+      this->s[i] = splitMix64 (&seed);
+    }
+}
+
+/**
+ * Returns the next random 64-bit word.
+ */
+uint64_t RandomGenerator::next ()
+{
+  uint64_t r = this->s[1] * 5;
+  uint64_t t = this->s[1] << 17;
+
+  r = ((r << 7) | (r >> 57)) * 9;
+
+  this->s[2] ^= this->s[0];
+  this->s[3] ^= this->s[1];
+  this->s[1] ^= this->s[2];
+  this->s[0] ^= this->s[3];
+  this->s[2] ^= t;
+  this->s[3] = (this->s[3] << 45) | (this->s[3] >> 19);
+
+  return (r);
+}
+
+/**
+ * Returns a random integer uniformly distributed in [0, range). Outputs from the incomplete last block of range values are rejected, so the result is unbiased.
+ * @param range The number of possible values. If 0, the full 64-bit word is returned.
+ */
+uint64_t RandomGenerator::nextBounded (uint64_t range)
+{
+  uint64_t r, threshold;
+
+  if (range == 0)
+    {
+      return (this->next ());
+    }
+
+  // 2^64 mod range: the outputs below it belong to the incomplete block
+  threshold = (0 - range) % range;
+
+  do
+    {
+      r = this->next ();
+    }
+  while (r < threshold);
+
+  return (r % range);
+}
+
+/**
+ * Fills the array words with random bits, for example one bit per cell of a board.
+ * @param words The array to be filled.
+ * @param nWords Number of words in the array.
+ */
+void RandomGenerator::fill (uint64_t *words, int nWords)
+{
+  int i;
+
+  for (i=0; i<nWords; i++)
+    {
+      words[i] = this->next ();
+    }
+}
+
 /**
- * Returns a random integer in the range of [min, max].
+ * Advances the SplitMix64 generator whose state is pointed to by state and returns its next output. It is used to expand and derive seeds.
+ * @param state Pointer to the state of the generator.
+ */
+uint64_t splitMix64 (uint64_t *state)
+{
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return (z ^ (z >> 31));
+}
+
+/**
+ * Returns the random number generator of the calling thread. Unless seedRandomGenerator is called, it is seeded from std::random_device when the thread first uses it.
+ */
+RandomGenerator *getThreadRandomGenerator ()
+{
+  static thread_local RandomGenerator generator (((uint64_t) std::random_device () () << 32) ^ std::random_device () ());
+  return (&generator);
+}
+
+/**
+ * Seeds the random number generator of the calling thread, so that the random numbers that follow are reproducible.
+ * @param seed The seed of the generator.
+ */
+void seedRandomGenerator (uint64_t seed)
+{
+  getThreadRandomGenerator ()->seed (seed);
+}
+
+/**
+ * Returns a random integer in the range of [min, max], both included, with every value equally likely.
  * @param min The lower bound of the random number returned. Default value is 0.
  * @param max The upper bound of the random number returned. Default value is 100.
  */
 int getRandomInteger (int min, int max)
 {
-  double s = rand ();
-  s = min + ((max-min)*(s/RAND_MAX));
-  return ( (int) s );
+  uint64_t range;
+
+  if (max <= min)
+    {
+      return (min);
+    }
+  range = (uint64_t) ((int64_t) max - (int64_t) min) + 1;
+  return ((int) ((int64_t) min + (int64_t) getThreadRandomGenerator ()->nextBounded (range)));
+}
+
+/**
+ * Returns a random 64-bit word with every bit drawn independently.
+ */
+uint64_t getRandomWord ()
+{
+  return (getThreadRandomGenerator ()->next ());
 }
 
 /**
- * Returns a random binary value (true/false). This is done by selecting a random integer between 1 and 8 (inclusive), and then returning whether the number is prime or not. The range of 1 to 8 is chosen, because it is the largest range over which the number of primes is equal to the number of non-primes.
+ * Fills the array words with random bits, for example one bit per cell of a board.
+ * @param words The array to be filled.
+ * @param nWords Number of words in the array.
+ */
+void getRandomBits (uint64_t *words, int nWords)
+{
+  getThreadRandomGenerator ()->fill (words, nWords);
+}
+
+/**
+ * Returns a random binary value (true/false), each with probability one half.
  */
 bool getRandomBinary ()
 {
-  return isPrime( getRandomInteger (1, 8) );
+  return ((getRandomWord () >> 63) != 0);
 }
 
 /**
@@ -79,3 +221,178 @@ bool isPrime (int n)
     }
 }
 
+/**
+ * Writes the nBytes low bytes of value to buffer, least significant byte first, so that binary files do not depend on the byte order of the machine.
+ * @param buffer The location where the bytes are written.
+ * @param value The value to be written.
+ * @param nBytes Number of bytes written, at most 8.
+ */
+void storeLittleEndian (unsigned char *buffer, uint64_t value, int nBytes)
+{
+  int i;
+
+  for (i=0; i<nBytes; i++)
+    {
+      buffer[i] = (unsigned char) (value >> (8*i));
+    }
+}
+
+/**
+ * Reads a value of nBytes bytes from buffer, least significant byte first.
+ * @param buffer The location from which the bytes are read.
+ * @param nBytes Number of bytes read, at most 8.
+ */
+uint64_t loadLittleEndian (const unsigned char *buffer, int nBytes)
+{
+  uint64_t value = 0;
+  int i;
+
+  for (i=0; i<nBytes; i++)
+    {
+      value |= ((uint64_t) buffer[i]) << (8*i);
+    }
+  return (value);
+}
+
+/**
+ * Returns the 32-bit FNV-1a checksum of the given bytes. A checksum over several blocks is computed by passing the checksum of the previous blocks as hash.
+ * @param buffer The bytes whose checksum is computed.
+ * @param nBytes Number of bytes in buffer.
+ * @param hash The checksum of the preceding bytes. Default value: the FNV-1a offset basis, for the first block.
+ */
+uint32_t checksum32 (const unsigned char *buffer, size_t nBytes, uint32_t hash)
+{
+  size_t i;
+
+  for (i=0; i<nBytes; i++)
+    {
+      hash ^= buffer[i];
+      hash *= 16777619U;
+    }
+  return (hash);
+}
+
+/**
+ * Returns whether the processor has the AVX2 instructions, checked once. It is always false where AVX2_DISPATCH is not defined.
+ */
+bool hasAvx2 ()
+{
+#ifdef AVX2_DISPATCH
+  static bool avx2 = (__builtin_cpu_init (), __builtin_cpu_supports ("avx2") != 0);
+  return (avx2);
+#else
+  return (false);
+#endif
+}
+
+#ifdef AVX2_DISPATCH
+/**
+ * Returns, in each 64-bit lane, the number of bits set in the lane of v. Each nibble is counted by a table lookup, and the counts of the bytes are summed by a sum of absolute differences with 0.
+ * @param v The four words whose set bits are to be counted.
+ */
+AVX2_TARGET static inline __m256i popCount256 (__m256i v)
+{
+  const __m256i lookup = _mm256_setr_epi8 (0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+					   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i lowNibbles = _mm256_set1_epi8 (0x0F);
+  __m256i low = _mm256_shuffle_epi8 (lookup, _mm256_and_si256 (v, lowNibbles));
+  __m256i high = _mm256_shuffle_epi8 (lookup, _mm256_and_si256 (_mm256_srli_epi16 (v, 4), lowNibbles));
+
+  return (_mm256_sad_epu8 (_mm256_add_epi8 (low, high), _mm256_setzero_si256 ()));
+}
+
+/**
+ * Returns the sum of the four 64-bit lanes of v.
+ * @param v The four lanes.
+ */
+AVX2_TARGET static inline uint64_t sumLanes (__m256i v)
+{
+  return ((uint64_t) _mm256_extract_epi64 (v, 0) + (uint64_t) _mm256_extract_epi64 (v, 1)
+	  + (uint64_t) _mm256_extract_epi64 (v, 2) + (uint64_t) _mm256_extract_epi64 (v, 3));
+}
+
+/**
+ * Returns the number of bits set in the first n words from words, n a multiple of 4, counted four words at a time.
+ * @param words The words whose set bits are to be counted.
+ * @param n Number of words.
+ */
+AVX2_TARGET static uint64_t popCountWordsAvx2 (const uint64_t *words, size_t n)
+{
+  __m256i counts = _mm256_setzero_si256 ();
+  size_t i;
+
+  for (i=0; i<n; i+=4)
+    {
+      counts = _mm256_add_epi64 (counts, popCount256 (_mm256_loadu_si256 ((const __m256i *) (words + i))));
+    }
+  return (sumLanes (counts));
+}
+
+/**
+ * Returns the number of bits that differ between the first n words from a and from b, n a multiple of 4, compared four words at a time.
+ * @param a The first words.
+ * @param b The second words.
+ * @param n Number of words.
+ */
+AVX2_TARGET static uint64_t xorPopCountWordsAvx2 (const uint64_t *a, const uint64_t *b, size_t n)
+{
+  __m256i counts = _mm256_setzero_si256 ();
+  size_t i;
+
+  for (i=0; i<n; i+=4)
+    {
+      counts = _mm256_add_epi64 (counts, popCount256 (_mm256_xor_si256 (_mm256_loadu_si256 ((const __m256i *) (a + i)),
+									  _mm256_loadu_si256 ((const __m256i *) (b + i)))));
+    }
+  return (sumLanes (counts));
+}
+#endif
+
+/**
+ * Returns the number of bits set in the n words from words. On a processor with AVX2, four words are counted at a time by nibble lookups.
+ * @param words The words whose set bits are to be counted.
+ * @param n Number of words.
+ */
+uint64_t popCountWords (const uint64_t *words, size_t n)
+{
+  uint64_t total = 0;
+  size_t i = 0;
+
+#ifdef AVX2_DISPATCH
+  if (hasAvx2 ())
+    {
+      i = n - n%4;
+      total = popCountWordsAvx2 (words, i);
+    }
+#endif
+  for (; i<n; i++)
+    {
+      total += (uint64_t) popCount (words[i]);
+    }
+  return (total);
+}
+
+/**
+ * Returns the number of bits that differ between the n words from a and the n words from b, that is the number of bits set in their XOR. On a processor with AVX2, four words are compared at a time.
+ * @param a The first words.
+ * @param b The second words.
+ * @param n Number of words.
+ */
+uint64_t xorPopCountWords (const uint64_t *a, const uint64_t *b, size_t n)
+{
+  uint64_t total = 0;
+  size_t i = 0;
+
+#ifdef AVX2_DISPATCH
+  if (hasAvx2 ())
+    {
+      i = n - n%4;
+      total = xorPopCountWordsAvx2 (a, b, i);
+    }
+#endif
+  for (; i<n; i++)
+    {
+      total += (uint64_t) popCount (a[i] ^ b[i]);
+    }
+  return (total);
+}
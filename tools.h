@@ -31,16 +31,93 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 /**
- * Returns a random integer in the range of [min, max].
+ * Defined where the AVX2 paths can be compiled whatever the flags of the build: 64-bit x86 with GCC or Clang, which compile a function for AVX2 when it is marked AVX2_TARGET. 32-bit x86 is left out, as the paths read 64-bit lanes with _mm256_extract_epi64, which it lacks. The AVX2 paths are only taken when hasAvx2 finds the instructions on the processor, so the same binary runs everywhere.
+ */
+#if defined(__GNUC__) && defined(__x86_64__)
+#define AVX2_DISPATCH
+#define AVX2_TARGET __attribute__ ((target ("avx2")))
+#endif
+
+/**
+ * The RandomGenerator class is a xoshiro256** pseudo-random number generator: 256 bits of state, a period of 2^256-1, and a few shifts and rotations per 64-bit output. Each thread has its own generator (see getThreadRandomGenerator), so threads never contend for random numbers, and a generator can be seeded explicitly for reproducible runs.
+ */
+class RandomGenerator
+{
+ private:
+  /**
+   * The state of the generator.
+   */
+  uint64_t s[4];
+
+ public:
+  /**
+   * Constructor that seeds the generator with the given seed.
+   * @param seed The seed of the generator.
+   */
+  RandomGenerator (uint64_t seed);
+  /**
+   * Seeds the generator. The 256 bits of state are expanded from the 64-bit seed by SplitMix64, so that close seeds give unrelated streams.
+   * @param seed The seed of the generator.
+   */
+  void seed (uint64_t seed);
+  /**
+   * Returns the next random 64-bit word.
+   */
+  uint64_t next ();
+  /**
+   * Returns a random integer uniformly distributed in [0, range). Outputs from the incomplete last block of range values are rejected, so the result is unbiased.
+   * @param range The number of possible values. If 0, the full 64-bit word is returned.
+   */
+  uint64_t nextBounded (uint64_t range);
+  /**
+   * Fills the array words with random bits, for example one bit per cell of a board.
+   * @param words The array to be filled.
+   * @param nWords Number of words in the array.
+   */
+  void fill (uint64_t *words, int nWords);
+};
+
+/**
+ * Advances the SplitMix64 generator whose state is pointed to by state and returns its next output. It is used to expand and derive seeds.
+ * @param state Pointer to the state of the generator.
+ */
+uint64_t splitMix64 (uint64_t *state);
+
+/**
+ * Returns the random number generator of the calling thread. Unless seedRandomGenerator is called, it is seeded from std::random_device when the thread first uses it.
+ */
+RandomGenerator *getThreadRandomGenerator ();
+
+/**
+ * Seeds the random number generator of the calling thread, so that the random numbers that follow are reproducible.
+ * @param seed The seed of the generator.
+ */
+void seedRandomGenerator (uint64_t seed);
+
+/**
+ * Returns a random integer in the range of [min, max], both included, with every value equally likely.
  * @param min The lower bound of the random number returned. Default value is 0.
  * @param max The upper bound of the random number returned. Default value is 100.
  */
 int getRandomInteger (int min=0, int max=100);
 
 /**
- * Returns a random binary value (true/false). This is done by selecting a random integer between 1 and 8 (inclusive), and then returning whether the number is prime or not. The range of 1 to 8 is chosen, because it is the largest range over which the number of primes is equal to the number of non-primes.
+ * Returns a random 64-bit word with every bit drawn independently.
+ */
+uint64_t getRandomWord ();
+
+/**
+ * Fills the array words with random bits, for example one bit per cell of a board.
+ * @param words The array to be filled.
+ * @param nWords Number of words in the array.
+ */
+void getRandomBits (uint64_t *words, int nWords);
+
+/**
+ * Returns a random binary value (true/false), each with probability one half.
  */
 bool getRandomBinary ();
 
@@ -50,4 +127,63 @@ bool getRandomBinary ();
  */
 bool isPrime (int n);
 
+/**
+ * Writes the nBytes low bytes of value to buffer, least significant byte first, so that binary files do not depend on the byte order of the machine.
+ * @param buffer The location where the bytes are written.
+ * @param value The value to be written.
+ * @param nBytes Number of bytes written, at most 8.
+ */
+void storeLittleEndian (unsigned char *buffer, uint64_t value, int nBytes);
+
+/**
+ * Reads a value of nBytes bytes from buffer, least significant byte first.
+ * @param buffer The location from which the bytes are read.
+ * @param nBytes Number of bytes read, at most 8.
+ */
+uint64_t loadLittleEndian (const unsigned char *buffer, int nBytes);
+
+/**
+ * Returns the 32-bit FNV-1a checksum of the given bytes. A checksum over several blocks is computed by passing the checksum of the previous blocks as hash.
+ * @param buffer The bytes whose checksum is computed.
+ * @param nBytes Number of bytes in buffer.
+ * @param hash The checksum of the preceding bytes. Default value: the FNV-1a offset basis, for the first block.
+ */
+uint32_t checksum32 (const unsigned char *buffer, size_t nBytes, uint32_t hash=2166136261U);
+
+/**
+ * Returns the number of bits set in the 64-bit word x. It is inline, as every move counts the cells it flips. The builtin is only used where it is a single instruction: without the popcnt instruction in the build, GCC makes it a call to its runtime library, slower than the inline bit count.
+ * @param x The word whose set bits are to be counted.
+ */
+inline int popCount (uint64_t x)
+{
+#if defined(__GNUC__) && (defined(__POPCNT__) || !(defined(__x86_64__) || defined(__i386__)))
+  return (__builtin_popcountll (x));
+#else
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return ((int) ((x * 0x0101010101010101ULL) >> 56));
+#endif
+}
+
+/**
+ * Returns whether the processor has the AVX2 instructions, checked once. It is always false where AVX2_DISPATCH is not defined.
+ */
+bool hasAvx2 ();
+
+/**
+ * Returns the number of bits set in the n words from words. On a processor with AVX2, four words are counted at a time by nibble lookups.
+ * @param words The words whose set bits are to be counted.
+ * @param n Number of words.
+ */
+uint64_t popCountWords (const uint64_t *words, size_t n);
+
+/**
+ * Returns the number of bits that differ between the n words from a and the n words from b, that is the number of bits set in their XOR. On a processor with AVX2, four words are compared at a time.
+ * @param a The first words.
+ * @param b The second words.
+ * @param n Number of words.
+ */
+uint64_t xorPopCountWords (const uint64_t *a, const uint64_t *b, size_t n);
+
 #endif